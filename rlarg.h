@@ -1,6 +1,8 @@
 #ifndef RLARG_H
 
 #include <rlso.h>
+#include <stddef.h>
+#include <stdint.h>
 
 struct Arg;
 struct Arg_Config;
@@ -13,12 +15,33 @@ typedef enum {
     ARG_BUILTIN_COLOR_ON,
 } Arg_Builtin_Color_List;
 
+/* caller storage, to register arguments without any allocation.
+ * declare with the maximum number of arguments and (sub) groups:
+ *      static ARG_STORAGE(storage, 64, 8);
+ *      arg_config_set_storage(cfg, storage, 64, 8);
+ */
+#define ARG_STORAGE_ARGX_SIZE   512
+#define ARG_STORAGE_GROUP_SIZE  128
+#define ARG_STORAGE_SIZE(n_argx, n_group)   ((n_argx) * ARG_STORAGE_ARGX_SIZE + (n_group) * ARG_STORAGE_GROUP_SIZE)
+#define ARG_STORAGE(name, n_argx, n_group)  _Alignas(max_align_t) unsigned char name[ARG_STORAGE_SIZE(n_argx, n_group)]
+
 /* rlarg/arg-core.c */
 struct Arg_Config *arg_config_new(void);
 void arg_config_set_program(struct Arg_Config *cfg, So program);
 void arg_config_set_description(struct Arg_Config *cfg, So desc);
 void arg_config_set_epilog(struct Arg_Config *cfg, So epilog);
 void arg_config_set_width(struct Arg_Config *cfg, size_t width);
+void arg_config_set_storage(struct Arg_Config *cfg, void *storage, size_t n_argx, size_t n_group);
+void arg_config_set_lazy(struct Arg_Config *cfg, bool lazy);
+/* scalars set by several layers (environment, configs, argv) only remember the most recent assignment,
+ * once everything is parsed only that one gets converted, read (file("...")) and its callback queued */
+void arg_config_set_layered(struct Arg_Config *cfg, bool layered);
+/* every configurable option can also be set by PREFIX_GROUP_OPTION, e.g. MYAPP_DEFAULT_INT for default.int
+ * ('-' and sub options become '_'); those override configs, argv overrides them */
+void arg_config_set_env_prefix(struct Arg_Config *cfg, So prefix);
+/* most threads running ARGX_PRIORITY_WHEN_ALL_VALID_PARALLEL callbacks, the calling one included.
+ * 0 (default) is one per queued callback, as they are usually waiting on I/O */
+void arg_config_set_parallel_workers(struct Arg_Config *cfg, size_t n);
 void arg_config_free(struct Arg_Config **cfg);
 
 struct Arg *arg_new(struct Arg_Config *cfg);
@@ -29,17 +52,78 @@ void arg_help_argx(struct Argx *help);
 void arg_config(struct Arg *arg);
 void arg_free(struct Arg **arg);
 
+/* drop everything a previous arg_parse left behind, to parse again with the same arguments.
+ * arrays are emptied, values with a reference get it back on the next parse, others keep their value.
+ * strings that were parsed from config files become invalid */
+void arg_reset(struct Arg *arg);
+
 void arg_enable_config_print(struct Arg *arg, bool enable);
 
+/* rlarg/arg-clone.c */
+/* independent copy of the registered arguments, e.g. one per thread; nothing of a parse is copied.
+ * the whole schema gets copied, so clone once per thread and arg_reset between parses.
+ * the copy still writes to the same variables as the original, move them with arg_rebind */
+struct Arg *arg_clone(struct Arg *arg);
+/* move every binding (values, references, callback and populate user data)
+ * that points into [from, from + size) to the same offset within to */
+void arg_rebind(struct Arg *arg, void *from, void *to, size_t size);
+
 /* rlarg/arg-runtime.c */
 void arg_runtime_quit_early(struct Argx *argx, bool val);
 void arg_runtime_quit_when_all_parsed(struct Argx *argx, bool val);
 void arg_runtime_set_parse_error_message(struct Argx *argx, char *fmt, ...);
 
 /* rlarg/arg-parse.c */
+typedef enum Arg_Parse_Error_List {
+    ARG_PARSE_ERROR_NONE,
+    ARG_PARSE_ERROR_NO_REST_ALLOWED,
+    ARG_PARSE_ERROR_UNHANDLED_POSITIONAL,
+    ARG_PARSE_ERROR_MISSING_POSITIONAL,
+    ARG_PARSE_ERROR_MISSING_VALUE,
+    ARG_PARSE_ERROR_MISSING_SHORTOPT,
+    ARG_PARSE_ERROR_MISSING_FILE_DELIM,
+    ARG_PARSE_ERROR_MISSING_ARRAY_DELIM,
+    ARG_PARSE_ERROR_MISSING_ARRAY_VALUE,
+    ARG_PARSE_ERROR_MISSING_HIERARCHY_DELIM,
+    ARG_PARSE_ERROR_MISSING_STRING_DELIM,
+    ARG_PARSE_ERROR_MISSING_SEQUENCE,
+    ARG_PARSE_ERROR_MISSING_REQUIRED,
+    ARG_PARSE_ERROR_CONFIG,
+    ARG_PARSE_ERROR_INVALID_CONVERSION,
+    ARG_PARSE_ERROR_INVALID_OPTION_GROUP,
+    ARG_PARSE_ERROR_INVALID_OPTION_ROOT,
+    ARG_PARSE_ERROR_INVALID_STRING,
+    ARG_PARSE_ERROR_INVALID_STRING_END,
+    ARG_PARSE_ERROR_INVALID_FILE,
+    ARG_PARSE_ERROR_INVALID_SECTION,
+    ARG_PARSE_ERROR_HIERARCHY_OPTION_CONFIG,
+    ARG_PARSE_ERROR_HIERARCHY_TABLE_CONFIG,
+    ARG_PARSE_ERROR_HIERARCHY_ROOT_CONFIG,
+    ARG_PARSE_ERROR_UNCONFIGURABLE,
+    ARG_PARSE_ERROR_DUPLICATE_KEY,
+} Arg_Parse_Error_List;
+
 int arg_parse(struct Arg *arg, const int argc, const char **argv, bool *quit_early);
 int arg_parse_config(struct Arg *arg, So config, So path);
 
+/* convert what a lazy argx (see argx_attr_lazy) got assigned, once; its value is valid afterwards.
+ * a conversion error gets reported here, returns nonzero only on the first call.
+ * arg_resolve does this for every argx, e.g. to validate everything at once */
+int argx_resolve(struct Argx *argx);
+int arg_resolve(struct Arg *arg);
+
+/* parse many command lines, separated by delim (e.g. '\n' or 0), each split into words like a shell would.
+ * every line starts from arg_reset; nothing gets printed, no configs get loaded and only callbacks of
+ * argx_attr_callback_batch get called. a line with a quote that never ends fails (ARG_PARSE_ERROR_MISSING_STRING_DELIM).
+ * report (optional) gets called after every line, parsed strings are only valid until it returns.
+ * returns the number of lines that failed */
+typedef void (*Arg_Batch_Function)(struct Arg *arg, size_t line, So cmd, int status, Arg_Parse_Error_List error, void *user);
+int arg_parse_batch(struct Arg *arg, So input, char delim, Arg_Batch_Function report, void *user);
+
+/* rlarg/arg-compgen.c */
+void arg_compgen_script(struct Arg *arg, So *out, So program);
+bool arg_compgen_cached(const int argc, const char **argv);
+
 /* rlarg/argx-group.c */
 struct Argx_Group *argx_group(struct Arg *arg, So name);
 
@@ -62,12 +146,14 @@ void argx_builtin_opt_so_fx(struct Argx *x, So_Fx *fmt, So_Fx *ref);
 struct Argx_Group *argx_builtin_rice(struct Arg *arg);
 
 typedef int (*Argx_Function)(struct Argx *argx, void *user, So so);
+typedef void (*Argx_Group_Populate)(struct Argx_Group *group, void *user);
 
 /* rlarg/argx-type.c */
 
 typedef enum {
     ARGX_PRIORITY_IMMEDIATELY,
     ARGX_PRIORITY_WHEN_ALL_VALID,
+    ARGX_PRIORITY_WHEN_ALL_VALID_PARALLEL,  /* on worker threads, after all of WHEN_ALL_VALID */
 } Argx_Priority_List;
 
 void argx_type_rest(struct Argx *argx, VSo *val);
@@ -76,22 +162,86 @@ void argx_type_uri(struct Argx *argx, So *val, So *ref);
 void argx_type_bool(struct Argx *argx, bool *val, bool *ref);
 void argx_type_int(struct Argx *argx, int *val, int *ref);
 void argx_type_size(struct Argx *argx, ssize_t *val, ssize_t *ref);
+void argx_type_double(struct Argx *argx, double *val, double *ref);
+void argx_type_float(struct Argx *argx, float *val, float *ref);
 void argx_type_color(struct Argx *argx, Color *val, Color *ref);
 void argx_type_switch(struct Argx *argx);
 
+/* an array not set anywhere shares the memory of its reference (default) array: don't modify it in place.
+ * the first value of a config, the environment or argv replaces the default, no matter if parsed before or after */
 void argx_type_array_so(struct Argx *argx, VSo *val, VSo *ref);
 void argx_type_array_uri(struct Argx *argx, VSo *val, VSo *ref);
 void argx_type_array_bool(struct Argx *argx, bool **val, bool **ref);
 void argx_type_array_int(struct Argx *argx, int **val, int **ref);
 void argx_type_array_size(struct Argx *argx, ssize_t **val, ssize_t **ref);
+void argx_type_array_double(struct Argx *argx, double **val, double **ref);
+void argx_type_array_float(struct Argx *argx, float **val, float **ref);
 void argx_type_array_color(struct Argx *argx, Color **val, Color **ref);
 
+/* bools packed into 64 bit words, bit i of the array is bit i % 64 of words[i / 64].
+ * takes [true,false,...], a single bool or a literal like 0b1011 / 0xff00 (first digit first) */
+typedef struct Argx_Bits {
+    uint64_t *words;    /* rlc array */
+    size_t len;         /* number of bits */
+} Argx_Bits;
+void argx_type_array_bits(struct Argx *argx, Argx_Bits *val, Argx_Bits *ref);
+void argx_bits_push(Argx_Bits *bits, bool bit);
+bool argx_bits_get(Argx_Bits *bits, size_t i);
+void argx_bits_free(Argx_Bits *bits);
+
+/* integer ranges like 0-63,128,200-255, kept sorted by lo with overlapping or adjacent ones merged */
+typedef struct Argx_Range {
+    ssize_t lo;
+    ssize_t hi;         /* inclusive */
+} Argx_Range;
+void argx_type_array_range(struct Argx *argx, Argx_Range **val, Argx_Range **ref);
+void argx_range_add(Argx_Range **ranges, ssize_t lo, ssize_t hi);
+bool argx_range_contains(Argx_Range *ranges, ssize_t i);
+
+/* strings hashed on insert, duplicates are dropped; like VSo the strings are not copied */
+typedef struct Argx_So_Set Argx_So_Set;
+void argx_type_set_so(struct Argx *argx, Argx_So_Set **val, Argx_So_Set **ref);
+bool argx_so_set_add(Argx_So_Set **set, So so);
+bool argx_so_set_has(Argx_So_Set *set, So so);
+size_t argx_so_set_len(Argx_So_Set *set);
+VSo argx_so_set_list(Argx_So_Set *set);
+void argx_so_set_free(Argx_So_Set **set);
+
+/* key=value pairs hashed by key, a key set again takes the new value (see argx_attr_unique_keys).
+ * the strings are not copied, each key remembers where it was set */
+typedef struct Argx_So_Map Argx_So_Map;
+void argx_type_map_so(struct Argx *argx, Argx_So_Map **val, Argx_So_Map **ref);
+void argx_so_map_set(Argx_So_Map **map, So key, So val);
+So *argx_so_map_get(Argx_So_Map *map, So key);
+size_t argx_so_map_len(Argx_So_Map *map);
+So argx_so_map_key(Argx_So_Map *map, size_t i);     /* in order of first insertion */
+So argx_so_map_val(Argx_So_Map *map, size_t i);
+void argx_so_map_fmt_source(So *out, Argx_So_Map *map, So key);
+void argx_so_map_free(Argx_So_Map **map);
+
+/* a type of your own, converted once and straight into the bound value.
+ * scalar: convert writes one value of size bytes, a default gets copied.
+ * array: val is your container, convert adds one value to it (or convert_array all of [a,b,...]) */
+typedef struct Argx_Type {
+    So hint;                                                /* shown as <hint> */
+    size_t size;                                            /* of one scalar value */
+    int (*convert)(void *val, So so, void *user);           /* 0 if valid */
+    void (*fmt)(So *out, void *val, void *user);            /* optional, for help and config generation */
+    void (*compgen)(VSo *candidates, void *user);           /* optional, the strings aren't freed */
+    int (*convert_array)(void *val, So so, void *user);     /* optional, else every value goes through convert */
+    void (*reset)(void *val, void *user);                   /* optional, empties an array container on arg_reset */
+} Argx_Type;
+void argx_type_custom(struct Argx *argx, const Argx_Type *type, void *user, void *val, void *ref);
+void argx_type_array_custom(struct Argx *argx, const Argx_Type *type, void *user, void *val);
+
 void argx_switch_none(struct Argx *switch_argx, struct Argx *argx);
 void argx_switch_so(struct Argx *switch_argx, struct Argx *argx, So val);
 void argx_switch_uri(struct Argx *switch_argx, struct Argx *argx, So val);
 void argx_switch_bool(struct Argx *switch_argx, struct Argx *argx, bool val);
 void argx_switch_int(struct Argx *switch_argx, struct Argx *argx, int val);
 void argx_switch_size(struct Argx *switch_argx, struct Argx *argx, ssize_t val);
+void argx_switch_double(struct Argx *switch_argx, struct Argx *argx, double val);
+void argx_switch_float(struct Argx *switch_argx, struct Argx *argx, float val);
 void argx_switch_color(struct Argx *switch_argx, struct Argx *argx, Color val);
 void argx_switch_flag(struct Argx *switch_argx, struct Argx *argx, bool value);
 
@@ -100,22 +250,41 @@ void argx_switch_array_uri(struct Argx *switch_argx, struct Argx *argx, VSo val)
 void argx_switch_array_bool(struct Argx *switch_argx, struct Argx *argx, bool *val);
 void argx_switch_array_int(struct Argx *switch_argx, struct Argx *argx, int *val);
 void argx_switch_array_size(struct Argx *switch_argx, struct Argx *argx, ssize_t *val);
+void argx_switch_array_double(struct Argx *switch_argx, struct Argx *argx, double *val);
+void argx_switch_array_float(struct Argx *switch_argx, struct Argx *argx, float *val);
 void argx_switch_array_color(struct Argx *switch_argx, struct Argx *argx, Color *val);
 
 struct Argx_Group *argx_group_enum(struct Argx *argx, int *val, int *ref);
 struct Argx_Group *argx_group_options(struct Argx *argx);
 struct Argx_Group *argx_group_flags(struct Argx *argx);
+/* flags of argx_flag_bit: each one is a bit of val (in order of registration), a list of them is applied in one go */
+struct Argx_Group *argx_group_flags_mask(struct Argx *argx, uint64_t *val, uint64_t *ref);
 struct Argx_Group *argx_group_sequence(struct Argx *argx);
 
+/* lazy groups: populate gets called the first time anything reaches the group.
+ * values of the sub options are untouched until then, so they should already hold their defaults */
+void argx_group_options_lazy(struct Argx *argx, Argx_Group_Populate populate, void *user);
+void argx_group_flags_lazy(struct Argx *argx, Argx_Group_Populate populate, void *user);
+
 struct Argx *argx_enum_bind(struct Argx_Group *group, int val, So name, So desc);
 
+/* subcommands: bind to the enum group of a positional argument. populate registers the options
+ * of the subcommand into a group named after it, and only gets called once it is selected (or
+ * looked up by help, a config section or completion). subcommands may reuse each others option
+ * names (long and short), only those of the selected one are parsed. names of other groups stay taken */
+struct Argx *argx_subcommand(struct Argx_Group *group, int val, So name, So desc, Argx_Group_Populate populate, void *user);
+
 struct Argx *argx_flag(struct Argx_Group *group, bool *val, bool *ref, So name, So desc);
+struct Argx *argx_flag_bit(struct Argx_Group *group, So name, So desc);
 
 void argx_hint_text(struct Argx *argx, So text);
 
 /* rlarg/argx-callback.h */
 
 void argx_callback(struct Argx *argx, Argx_Function func, void *user, Argx_Priority_List priority);
+/* a parallel callback of argx only starts once the one of before (if queued) has finished.
+ * aborts if before already runs after argx */
+void argx_callback_after(struct Argx *argx, struct Argx *before);
 
 /* rlarg/argx-attr.c */
 
@@ -123,8 +292,16 @@ void argx_attr_hide(struct Argx *argx, bool hide);
 void argx_attr_configurable(struct Argx *argx, bool configurable);
 void argx_attr_required(struct Argx *argx, bool required);
 void argx_attr_callback_skip_compgen(struct Argx *argx, bool skip);
+/* the callback only validates (no side effects), so arg_parse_batch calls it as well */
+void argx_attr_callback_batch(struct Argx *argx, bool run);
 void argx_attr_explicit_bool(struct Argx *argx, bool explicit);
 void argx_attr_fatal_config_error(struct Argx *argx, bool fatal);
+/* a map rejects a key set twice by the same source (argv, or one config), instead of the last one winning.
+ * a later source still overrides it, e.g. argv a key of a config */
+void argx_attr_unique_keys(struct Argx *argx, bool unique);
+/* only remember the raw value while parsing; convert it (and run a
+ * WHEN_ALL_VALID callback) once argx_resolve gets called */
+void argx_attr_lazy(struct Argx *argx, bool lazy);
 
 /* rlarg/arg-after.c */
 
@@ -2,10 +2,9 @@
 
 void arg_after_fmt_config_available(So *out, struct Arg *arg) {
 
-    Argx_Group **itE = array_itE(arg->opts);
-    for(Argx_Group **it = arg->opts; it < itE; ++it) {
-        so_extend(out, (*it)->name);
-        if(it + 1 < itE) so_push(out, ',');
+    for(Argx_Group *it = arg->opts; it; it = it->next) {
+        so_extend(out, it->name);
+        if(it->next) so_push(out, ',');
     }
 
 }
@@ -0,0 +1,170 @@
+#include "arg.h"
+
+/* rebinding {{{ */
+
+static void *static_arg_rebind_ptr(void *p, void *from, void *to, size_t size) {
+    unsigned char *c = p, *c0 = from;
+    if(!c || c < c0 || c >= c0 + size) return p;
+    return (unsigned char *)to + (c - c0);
+}
+
+static void static_arg_rebind_argx(Argx *argx, void *from, void *to, size_t size) {
+    if(argx->id != ARGX_TYPE_SWITCH) {
+        argx->val.any = static_arg_rebind_ptr(argx->val.any, from, to, size);
+    }
+    argx->ref.any = static_arg_rebind_ptr(argx->ref.any, from, to, size);
+    argx->callback.user = static_arg_rebind_ptr(argx->callback.user, from, to, size);
+    argx->lazy.user = static_arg_rebind_ptr(argx->lazy.user, from, to, size);
+    argx->custom.user = static_arg_rebind_ptr(argx->custom.user, from, to, size);
+}
+
+static void static_arg_rebind_group(Argx_Group *group, void *from, void *to, size_t size) {
+    for(Argx *it = group->list; it; it = it->next) {
+        static_arg_rebind_argx(it, from, to, size);
+        if(it->group_s) static_arg_rebind_group(it->group_s, from, to, size);
+    }
+}
+
+void arg_rebind(struct Arg *arg, void *from, void *to, size_t size) {
+    ASSERT_ARG(arg);
+    ASSERT_ARG(from);
+    ASSERT_ARG(to);
+    static_arg_rebind_group(&arg->pos, from, to, size);
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        static_arg_rebind_group(group, from, to, size);
+    }
+    static_arg_rebind_group(&arg->env, from, to, size);
+}
+
+/* rebinding }}} */
+
+/* cloning {{{ */
+
+/* counterpart of an argx within the clone, found by its hierarchy */
+static Argx *static_arg_clone_find(struct Arg *clone, struct Arg *arg, Argx *argx) {
+    if(!argx) return 0;
+    Argx_Group *group = argx->group_p;
+    Argx_Group *scope = 0;
+    if(group->parent) {
+        Argx *parent = static_arg_clone_find(clone, arg, group->parent);
+        scope = parent ? parent->group_s : 0;
+    } else if(group == &arg->pos) {
+        scope = &clone->pos;
+    } else if(group == &arg->env) {
+        scope = &clone->env;
+    } else {
+        scope = argx_group_get_opt(clone, group->name);
+    }
+    return scope ? argx_group_get(scope, argx->opt) : 0;
+}
+
+static size_t static_arg_clone_switch_size(Argx *argx) {
+    if(argx->attr.is_array) return sizeof(void *);
+    switch(argx->id) {
+        case ARGX_TYPE_INT: return sizeof(int);
+        case ARGX_TYPE_SIZE: return sizeof(ssize_t);
+        case ARGX_TYPE_DOUBLE: return sizeof(double);
+        case ARGX_TYPE_FLOAT: return sizeof(float);
+        case ARGX_TYPE_FLAG:
+        case ARGX_TYPE_BOOL: return sizeof(bool);
+        case ARGX_TYPE_URI:
+        case ARGX_TYPE_STRING: return sizeof(So);
+        case ARGX_TYPE_COLOR: return sizeof(Color);
+        case ARGX_TYPE_CUSTOM: return argx->custom.type->size;
+        default: return 0;
+    }
+}
+
+static void static_arg_clone_group(Argx_Group *dest, Argx_Group *src) {
+    for(Argx *it = src->list; it; it = it->next) {
+        Argx *x = argx_opt(dest, it->c, it->opt, it->desc);
+        x->val = it->val;
+        x->ref = it->ref;
+        x->hint = it->hint;
+        x->id = it->id;
+        x->lazy = it->lazy;
+        x->custom = it->custom;
+        x->callback = it->callback;
+        x->callback.after = 0;
+        x->attr = it->attr;
+        /* switches point to other argx, filled in once all of them exist */
+        if(x->id == ARGX_TYPE_SWITCH) x->val.sw = 0;
+        if(it->group_s) {
+            x->group_s = argx_group_new(x, it->group_s->id);
+            x->group_s->is_bitmask = it->group_s->is_bitmask;
+            static_arg_clone_group(x->group_s, it->group_s);
+        }
+    }
+}
+
+/* point everything that referred to the original to the clone instead */
+static void static_arg_clone_link(struct Arg *clone, struct Arg *arg, Argx_Group *src) {
+    for(Argx *it = src->list; it; it = it->next) {
+        Argx *x = static_arg_clone_find(clone, arg, it);
+        ASSERT_ARG(x);
+        static_arg_rebind_argx(x, arg, clone, sizeof(*arg));
+        /* e.g. the config print flags */
+        for(Argx_Group *g = arg->opts, *h = clone->opts; g && h; g = g->next, h = h->next) {
+            static_arg_rebind_argx(x, g, h, sizeof(*g));
+        }
+        if(it->id == ARGX_TYPE_SWITCH) {
+            Argx_Switch *swE = array_itE(it->val.sw);
+            for(Argx_Switch *sw = it->val.sw; sw < swE; ++sw) {
+                Argx_Switch copy = { .argx = static_arg_clone_find(clone, arg, sw->argx) };
+                ASSERT_ARG(copy.argx);
+                size_t size = static_arg_clone_switch_size(sw->argx);
+                if(size && sw->val.any) {
+                    copy.val.any = malloc(size);
+                    if(!copy.val.any) ABORT(ERR_MEMORY);
+                    memcpy(copy.val.any, sw->val.any, size);
+                }
+                array_push(x->val.sw, copy);
+            }
+        }
+        Argx **afterE = array_itE(it->callback.after);
+        for(Argx **after = it->callback.after; after < afterE; ++after) {
+            Argx *before = static_arg_clone_find(clone, arg, *after);
+            ASSERT_ARG(before);
+            array_push(x->callback.after, before);
+        }
+        if(x->attr.is_required) arg_required_push(clone, x);
+        if(it->group_s) static_arg_clone_link(clone, arg, it->group_s);
+    }
+}
+
+struct Arg *arg_clone(struct Arg *arg) {
+    ASSERT_ARG(arg);
+    Arg_Config cfg = arg->config;
+    cfg.storage.buf = 0;
+    cfg.storage.n_argx = 0;
+    cfg.storage.n_group = 0;
+    Arg *clone = arg_new(&cfg);
+    clone->rice = arg->rice;
+    arg_init_al(&clone->rice, clone, &clone->print.p_al2, false);
+    clone->builtin.color = arg->builtin.color;
+    clone->builtin.config_use_builtin = arg->builtin.config_use_builtin;
+
+    static_arg_clone_group(&clone->pos, &arg->pos);
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        static_arg_clone_group(argx_group_root(clone, group->name, group->is_subcommand), group);
+    }
+    static_arg_clone_group(&clone->env, &arg->env);
+
+    static_arg_clone_link(clone, arg, &arg->pos);
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        static_arg_clone_link(clone, arg, group);
+    }
+    static_arg_clone_link(clone, arg, &arg->env);
+
+    clone->help.argx = static_arg_clone_find(clone, arg, arg->help.argx);
+    clone->builtin.version_argx = static_arg_clone_find(clone, arg, arg->builtin.version_argx);
+    clone->builtin.sources_argx = static_arg_clone_find(clone, arg, arg->builtin.sources_argx);
+    array_extend(clone->builtin.sources_default, arg->builtin.sources_default);
+    array_extend(clone->builtin.sources_vso, arg->builtin.sources_default);
+    /* the values might get moved with arg_rebind, write the references on the first parse */
+    clone->setref_all = true;
+    return clone;
+}
+
+/* cloning }}} */
+
@@ -1,31 +1,88 @@
 #include "arg-compgen.h"
 #include "arg.h"
 #include "argx-so.h"
+#include <ctype.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-#define ARG_COMPGEN_DELIM   0   //'\n'
+/* reply: a newline (cuts off anything printed before), then every
+ * candidate quoted for bash and terminated by ARG_COMPGEN_DELIM */
+#define ARG_COMPGEN_DELIM   0
+
+/* the part of the word that gets completed; for --option=<tab> only the value */
+static So static_arg_compgen_value(So word) {
+    if(so_at0(word) == '-') {
+        size_t i = so_find_ch(word, '=');
+        if(i < so_len(word)) return so_i0(word, i + 1);
+    }
+    return word;
+}
+
+static So static_arg_compgen_word(struct Arg *arg) {
+    return static_arg_compgen_value(arg->builtin.compgen_word);
+}
+
+/* check if pre + name + post starts with the word */
+static bool static_arg_compgen_match(So word, So pre, So name, So post) {
+    So parts[] = { pre, name, post };
+    for(size_t i = 0; i < 3 && so_len(word); ++i) {
+        size_t n = so_len(word) < so_len(parts[i]) ? so_len(word) : so_len(parts[i]);
+        if(so_cmp0(parts[i], so_iE(word, n))) return false;
+        word = so_i0(word, n);
+    }
+    return !so_len(word);
+}
+
+/* quote like printf %q in bash would */
+static void static_arg_compgen_quote(So so) {
+    for(size_t i = 0; i < so_len(so); ++i) {
+        unsigned char c = so_at(so, i);
+        if(c < ' ' || c == 0x7f) {
+            printf("$'\\x%02x'", c);
+            continue;
+        }
+        if(strchr(" \t'\"\\|&;()<>!{}[]*?$`#~^", c)) fputc('\\', stdout);
+        fputc(c, stdout);
+    }
+}
+
+static void static_arg_compgen_emit(bool *nfirst, So word, So pre, So name, So post) {
+    if(!static_arg_compgen_match(word, pre, name, post)) return;
+    if(!*nfirst) {
+        *nfirst = true;
+        fputc('\n', stdout);
+    }
+    static_arg_compgen_quote(pre);
+    static_arg_compgen_quote(name);
+    static_arg_compgen_quote(post);
+    fputc(ARG_COMPGEN_DELIM, stdout);
+}
+
+static void static_arg_compgen_print(struct Arg *arg, So pre, So name, So post) {
+    static_arg_compgen_emit(&arg->print.compgen_nfirst, static_arg_compgen_word(arg), pre, name, post);
+}
 
 void arg_compgen_argx_hierarchy(struct Argx *argx) {
     Argx_Group *group = argx->group_p;
-    bool is_pos = (group->table == &group->arg->t_pos);
+    bool is_pos = (group == &group->arg->pos);
     if(is_pos) return;
-    bool treat_as_options = (group->table == &group->arg->t_opt);
+    bool treat_as_options = (group->id == ARGX_GROUP_ROOT && group != &group->arg->env);
     if(!group->arg->builtin.compgen_flags) {
         if(!group->arg->help.error && treat_as_options) return;
     }
-    printf("%c", ARG_COMPGEN_DELIM);
-    if(treat_as_options) printf("--");
-    printf("%.*s", SO_F(argx->opt));
+    Arg *arg = group->arg;
+    static_arg_compgen_print(arg, treat_as_options ? so("--") : SO, argx->opt, SO);
     if(argx->c) {
         ASSERT(treat_as_options, "should always have an option, if we do short opts");
-        printf("%c-%c", ARG_COMPGEN_DELIM, argx->c);
+        static_arg_compgen_print(arg, so("-"), so_ll((char *)&argx->c, 1), SO);
     }
 }
 
 void arg_compgen_group(Argx_Group *group) {
     if(!group) return;
-    Argx **itE = array_itE(group->list);
-    for(Argx **it = group->list; it < itE; ++it) {
-        arg_compgen_argx_hierarchy(*it);
+    for(Argx *it = group->list; it; it = it->next) {
+        arg_compgen_argx_hierarchy(it);
     }
 }
 
@@ -36,17 +93,28 @@ static void static_arg_compgen_argx(struct Arg *arg, struct Argx *argx) {
         case ARGX_TYPE_NONE:
         case ARGX_TYPE_INT:
         case ARGX_TYPE_SIZE:
+        case ARGX_TYPE_DOUBLE:
+        case ARGX_TYPE_FLOAT:
         case ARGX_TYPE_COLOR:
         case ARGX_TYPE_STRING: break; /* can not provide compgen */
+        case ARGX_TYPE_CUSTOM: {
+            VSo candidates = 0;
+            if(argx->custom.type->compgen) argx->custom.type->compgen(&candidates, argx->custom.user);
+            for(size_t i = 0; i < array_len(candidates); ++i) {
+                static_arg_compgen_print(arg, SO, array_at(candidates, i), SO);
+            }
+            array_free(candidates);
+        } break;
         case ARGX_TYPE_BOOL: {
-            printf("%ctrue%cfalse", ARG_COMPGEN_DELIM, ARG_COMPGEN_DELIM);
+            static_arg_compgen_print(arg, SO, so("true"), SO);
+            static_arg_compgen_print(arg, SO, so("false"), SO);
         } break;
         case ARGX_TYPE_FLAG:
         case ARGX_TYPE_ENUM: {
-            printf("%c%.*s", ARG_COMPGEN_DELIM, SO_F(argx->opt));
+            static_arg_compgen_print(arg, SO, argx->opt, SO);
         } break;
         case ARGX_TYPE_GROUP: {
-            Argx_Group *sub = argx->group_s;
+            Argx_Group *sub = argx_group_sub(argx);
             ASSERT_ARG(sub);
             arg_compgen_group(sub);
         } break;
@@ -58,16 +126,19 @@ void arg_compgen_global(struct Arg *arg) {
     if(arg->builtin.compgen_done) return;
     arg->builtin.compgen_done = true;
     ASSERT_ARG(arg);
-    for(Argx_Group **group = arg->opts; group < array_itE(arg->opts); ++group) {
-        arg_compgen_group(*group);
+    /* options can only match if the word is empty or starts with a dash */
+    So word = static_arg_compgen_word(arg);
+    bool options = !so_len(word) || so_at0(word) == '-';
+    for(Argx_Group *group = arg->opts; group && options; group = group->next) {
+        if(group->is_subcommand && group != arg->subcommand) continue;
+        arg_compgen_group(group);
     }
     arg_compgen_group(&arg->pos);
     /* also print the argx information about the next positional in line BUT only if the current help is not the --help argx */
     if(arg->help.last != arg->help.argx) {
-        Argx *argx = arg->i_pos < array_len(arg->pos.list) ? array_at(arg->pos.list, arg->i_pos) : 0;
+        Argx *argx = argx_group_at(&arg->pos, arg->i_pos);
         static_arg_compgen_argx(arg, argx);
     }
-    printf("\n");
 }
 
 void arg_compgen_argx(struct Arg *arg, struct Argx *argx) {
@@ -78,17 +149,16 @@ void arg_compgen_argx(struct Arg *arg, struct Argx *argx) {
     if(arg->builtin.compgen_done) return;
     arg->builtin.compgen_done = true;
     static_arg_compgen_argx(arg, argx);
-    printf("\n");
 }
 
 void arg_compgen_help_argx(struct Arg *arg, struct Argx *argx) {
     So hier = SO;
     Arg_Rice no_rice = {0};
     if(argx->id == ARGX_TYPE_GROUP) {
-        arg_compgen_help_group(arg, argx->group_s);
+        arg_compgen_help_group(arg, argx_group_sub(argx));
     } else {
         argx_so_hierarchy(&hier, &no_rice, argx->group_p);
-        printf("%c%.*s%.*s", ARG_COMPGEN_DELIM, SO_F(hier), SO_F(argx->opt));
+        static_arg_compgen_print(arg, hier, argx->opt, SO);
     }
     so_free(&hier);
 }
@@ -97,14 +167,10 @@ void arg_compgen_help_group(struct Arg *arg, struct Argx_Group *group) {
     //Argx_So xso = {0};
     So hier = SO;
     Arg_Rice no_rice = {0};
-    Argx **itE = array_itE(group->list);
-    for(Argx **it = group->list; it < itE; ++it) {
+    for(Argx *it = group->list; it; it = it->next) {
         so_clear(&hier);
-        argx_so_hierarchy(&hier, &no_rice, (*it)->group_p);
-        printf("%c%.*s%.*s", ARG_COMPGEN_DELIM, SO_F(hier), SO_F((*it)->opt));
-        if((*it)->id == ARGX_TYPE_GROUP) {
-            printf(".");
-        }
+        argx_so_hierarchy(&hier, &no_rice, it->group_p);
+        static_arg_compgen_print(arg, hier, it->opt, it->id == ARGX_TYPE_GROUP ? so(".") : SO);
     }
     so_free(&hier);
 
@@ -112,12 +178,497 @@ void arg_compgen_help_group(struct Arg *arg, struct Argx_Group *group) {
 }
 
 void arg_compgen_help_groups(struct Arg *arg) {
-    Argx_Group **itE = array_itE(arg->opts);
-    for(Argx_Group **it = arg->opts; it < itE; ++it) {
-        printf("%c%.*s.", ARG_COMPGEN_DELIM, SO_F((*it)->name));
+    for(Argx_Group *it = arg->opts; it; it = it->next) {
+        static_arg_compgen_print(arg, SO, it->name, so("."));
+    }
+    /* subcommands that were not selected, without building them */
+    for(Argx *pos = arg->pos.list; pos; pos = pos->next) {
+        if(!pos->group_s || pos->group_s->id != ARGX_GROUP_ENUM) continue;
+        for(Argx *it = pos->group_s->list; it; it = it->next) {
+            if(it->lazy.populate) static_arg_compgen_print(arg, SO, it->opt, so("."));
+        }
+    }
+    static_arg_compgen_print(arg, SO, arg->pos.name, so("."));
+    static_arg_compgen_print(arg, SO, arg->env.name, so("."));
+}
+
+
+/* walking all candidates, for the script and the cache {{{ */
+
+typedef void (*Arg_Compgen_Word)(So *out, So pre, So name, So post);
+
+/* subcommands may share names; without knowing the command line, the first one answers */
+static bool static_arg_compgen_taken(struct Arg *arg, Argx_Group *until, So opt, char c) {
+    for(Argx_Group *group = arg->opts; group != until; group = group->next) {
+        if(!group->is_subcommand) continue;
+        if(c ? (bool)argx_group_get_short(group, c) : (bool)argx_group_get(group, opt)) return true;
+    }
+    return false;
+}
+
+static bool static_arg_compgen_values(So *out, Arg_Compgen_Word word, Argx *argx) {
+    size_t len = so_len(*out);
+    switch(argx->id) {
+        case ARGX_TYPE_BOOL: {
+            word(out, SO, so("true"), SO);
+            word(out, SO, so("false"), SO);
+        } break;
+        case ARGX_TYPE_GROUP: {
+            for(Argx *it = argx_group_sub(argx)->list; it; it = it->next) {
+                word(out, SO, it->opt, SO);
+            }
+        } break;
+        case ARGX_TYPE_CUSTOM: {
+            VSo candidates = 0;
+            if(argx->custom.type->compgen) argx->custom.type->compgen(&candidates, argx->custom.user);
+            for(size_t i = 0; i < array_len(candidates); ++i) {
+                word(out, SO, array_at(candidates, i), SO);
+            }
+            array_free(candidates);
+        } break;
+        default: break;
+    }
+    return so_len(*out) != len;
+}
+
+static void static_arg_compgen_help(So *out, Arg_Compgen_Word word, Argx_Group *group) {
+    So hier = SO;
+    Arg_Rice no_rice = {0};
+    argx_so_hierarchy(&hier, &no_rice, group);
+    for(Argx *it = group->list; it; it = it->next) {
+        word(out, hier, it->opt, it->id == ARGX_TYPE_GROUP ? so(".") : SO);
+        if(it->id == ARGX_TYPE_GROUP) {
+            static_arg_compgen_help(out, word, argx_group_sub(it));
+        }
+    }
+    so_free(&hier);
+}
+
+static void static_arg_compgen_help_all(So *out, Arg_Compgen_Word word, struct Arg *arg) {
+    Argx_Group *roots[] = { &arg->pos, &arg->env };
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        word(out, SO, group->name, so("."));
+        static_arg_compgen_help(out, word, group);
+    }
+    for(size_t i = 0; i < 2; ++i) {
+        word(out, SO, roots[i]->name, so("."));
+        static_arg_compgen_help(out, word, roots[i]);
+    }
+}
+
+/* walking all candidates }}} */
+
+/* static completion script {{{ */
+
+/* append pre + name + post as one single-quoted bash word */
+static void static_arg_compgen_script_quote(So *out, So pre, So name, So post) {
+    So parts[] = { pre, name, post };
+    so_push(out, '\'');
+    for(size_t i = 0; i < 3; ++i) {
+        for(size_t j = 0; j < so_len(parts[i]); ++j) {
+            char c = so_at(parts[i], j);
+            if(c == '\'') so_extend(out, so("'\\''"));
+            else so_push(out, c);
+        }
+    }
+    so_push(out, '\'');
+}
+
+static void static_arg_compgen_script_word(So *out, So pre, So name, So post) {
+    so_push(out, ' ');
+    static_arg_compgen_script_quote(out, pre, name, post);
+}
+
+/* case pattern of an option, e.g. '--color'|'-c' */
+static void static_arg_compgen_script_pattern(So *out, Argx *argx, So post) {
+    if(so_len(*out) && so_atE(*out) != ' ') so_push(out, '|');
+    static_arg_compgen_script_quote(out, so("--"), argx->opt, post);
+    if(argx->c) {
+        so_push(out, '|');
+        static_arg_compgen_script_quote(out, so("-"), so_ll((char *)&argx->c, 1), post);
+    }
+}
+
+void arg_compgen_script(struct Arg *arg, So *out, So program) {
+    ASSERT_ARG(arg);
+    ASSERT_ARG(out);
+    size_t i0 = so_len(program);
+    while(i0 && so_at(program, i0 - 1) != '/') --i0;
+    program = so_i0(program, i0);
+    /* function names only get letters, digits and underscores */
+    So func = SO;
+    for(size_t i = 0; i < so_len(program); ++i) {
+        char c = so_at(program, i);
+        so_push(&func, isalnum((unsigned char)c) ? c : '_');
+    }
+
+    /* the script is generated once, so it covers every subcommand */
+    arg_subcommands_build(arg);
+    /* sort root options by what follows them */
+    So p_help = SO, p_rest = SO, p_takes = SO, p_values = SO, w_opts = SO;
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        for(Argx *it = group->list; it; it = it->next) {
+            if(!static_arg_compgen_taken(arg, group, it->opt, 0)) {
+                static_arg_compgen_script_word(&w_opts, so("--"), it->opt, SO);
+            }
+            if(it->c && !static_arg_compgen_taken(arg, group, SO, it->c)) {
+                static_arg_compgen_script_word(&w_opts, so("-"), so_ll((char *)&it->c, 1), SO);
+            }
+            if(it == arg->help.argx) {
+                static_arg_compgen_script_pattern(&p_help, it, SO);
+                continue;
+            }
+            int n = arg_parse_argx_n_values(it);
+            if(it->id == ARGX_TYPE_REST) {
+                static_arg_compgen_script_pattern(&p_rest, it, SO);
+            } else if(n) {
+                static_arg_compgen_script_pattern(&p_takes, it, SO);
+            }
+            So values = SO;
+            if(static_arg_compgen_values(&values, static_arg_compgen_script_word, it)) {
+                so_extend(&p_values, so("            "));
+                if(n) static_arg_compgen_script_pattern(&p_values, it, SO);
+                static_arg_compgen_script_pattern(&p_values, it, so("="));
+                so_fmt(&p_values, ") words=(%.*s) ;;\n", SO_F(values));
+            }
+            so_free(&values);
+        }
+    }
+
+    so_fmt(out, "# bash completion for %.*s, generated by rlarg\n", SO_F(program));
+    so_fmt(out, "_complete_%.*s() {\n", SO_F(func));
+    so_extend(out, so(
+        "    local cur=\"${COMP_WORDS[COMP_CWORD]}\" key=\"${COMP_WORDS[COMP_CWORD-1]}\" pre=\"\" w i\n"
+        "    local -a words=()\n"
+        "    local n_pos=0 takes=0 help=0 rest=0\n"
+        "    # --option=value, depending on whether bash splits on '='\n"
+        "    if [[ \"${cur}\" == \"=\" ]]; then\n"
+        "        cur=\"\"; key=\"${key}=\"\n"
+        "    elif [[ \"${key}\" == \"=\" ]]; then\n"
+        "        key=\"${COMP_WORDS[COMP_CWORD-2]}=\"\n"
+        "    elif [[ \"${cur}\" == -*=* ]]; then\n"
+        "        pre=\"${cur%%=*}=\"; key=\"${pre}\"; cur=\"${cur#*=}\"\n"
+        "    fi\n"
+        "    for ((i = 1; i < COMP_CWORD; ++i)); do\n"
+        "        w=\"${COMP_WORDS[i]}\"\n"
+        "        if [[ \"${w}\" == \"=\" ]]; then takes=1; continue; fi\n"
+        "        if ((takes)); then takes=0; continue; fi\n"
+        "        case \"${w}\" in\n"));
+    if(so_len(p_help)) so_fmt(out, "            %.*s) help=1; break ;;\n", SO_F(p_help));
+    if(so_len(p_rest)) so_fmt(out, "            %.*s) rest=1; break ;;\n", SO_F(p_rest));
+    if(so_len(p_takes)) so_fmt(out, "            %.*s) takes=1 ;;\n", SO_F(p_takes));
+    so_extend(out, so(
+        "            -*) ;;\n"
+        "            *) ((++n_pos)) ;;\n"
+        "        esac\n"
+        "    done\n"
+        "    if ((rest)); then\n"
+        "        return\n"
+        "    elif ((help)); then\n"
+        "        words=("));
+    static_arg_compgen_help_all(out, static_arg_compgen_script_word, arg);
+    so_extend(out, so(" )\n"
+        "    elif ((takes)) || [[ \"${key}\" == *= ]]; then\n"
+        "        case \"${key}\" in\n"));
+    so_extend(out, p_values);
+    so_extend(out, so(
+        "        esac\n"
+        "    elif [[ \"${cur}\" == -* ]]; then\n"));
+    so_fmt(out, "        words=(%.*s )\n", SO_F(w_opts));
+    so_extend(out, so(
+        "    else\n"
+        "        case \"${n_pos}\" in\n"));
+    size_t i_pos = 0;
+    for(Argx *it = arg->pos.list; it; it = it->next, ++i_pos) {
+        So values = SO;
+        if(static_arg_compgen_values(&values, static_arg_compgen_script_word, it)) {
+            so_fmt(out, "            %zu) words=(%.*s) ;;\n", i_pos, SO_F(values));
+        }
+        so_free(&values);
+    }
+    so_extend(out, so(
+        "        esac\n"
+        "    fi\n"
+        "    COMPREPLY=()\n"
+        "    for w in \"${words[@]}\"; do\n"
+        "        [[ \"${w}\" == \"${cur}\"* ]] || continue\n"
+        "        # help topics: one level at a time\n"
+        "        if ((help)); then\n"
+        "            i=\"${w#\"${cur}\"}\"\n"
+        "            [[ \"${i%.}\" == *.* ]] && continue\n"
+        "            [[ -z \"${i}\" && \"${w}\" == *. ]] && continue\n"
+        "        fi\n"
+        "        printf -v w '%q' \"${pre}${w}\"\n"
+        "        COMPREPLY+=(\"${w}\")\n"
+        "    done\n"
+        "    if [[ \"${COMPREPLY[0]}\" == *. ]]; then\n"
+        "        compopt -o nospace\n"
+        "    fi\n"
+        "}\n"));
+    so_fmt(out, "complete -o bashdefault -o default -F _complete_%.*s %.*s\n", SO_F(func), SO_F(program));
+
+    so_free(&p_help);
+    so_free(&p_rest);
+    so_free(&p_takes);
+    so_free(&p_values);
+    so_free(&w_opts);
+    so_free(&func);
+}
+
+/* static completion script }}} */
+
+
+/* completion cache {{{ */
+
+/* header: magic, then a stat line of the executable and of every source,
+ * ending with an empty line. followed by records:
+ *      kind, key, null character, candidates each terminated by a null character, null character */
+#define ARG_COMPGEN_CACHE_MAGIC     "rlarg-compgen-cache 1\n"
+
+typedef enum {
+    ARG_COMPGEN_CACHE_OPTION = 'o',     /* option without value */
+    ARG_COMPGEN_CACHE_TAKES = 't',      /* option consuming the next word */
+    ARG_COMPGEN_CACHE_HELP = 'h',
+    ARG_COMPGEN_CACHE_REST = 'r',
+    ARG_COMPGEN_CACHE_POSITIONAL = 'p',
+    ARG_COMPGEN_CACHE_HIERARCHY = 'y',
+} Arg_Compgen_Cache_List;
+
+#define ARG_COMPGEN_CACHE_OPTIONS   "othr"
+
+static void static_arg_compgen_cache_word(So *out, So pre, So name, So post) {
+    so_extend(out, pre);
+    so_extend(out, name);
+    so_extend(out, post);
+    so_push(out, 0);
+}
+
+static void static_arg_compgen_cache_stat(So *out, So path) {
+    char cpath[PATH_MAX] = {0};
+    struct stat st = {0};
+    if(so_len(path) < sizeof(cpath)) {
+        memcpy(cpath, path.str, so_len(path));
+        stat(cpath, &st);
+    }
+    so_fmt(out, "%ju %ju %jd %ld %.*s\n", (uintmax_t)st.st_dev, (uintmax_t)st.st_ino,
+            (intmax_t)st.st_mtim.tv_sec, (long)st.st_mtim.tv_nsec, SO_F(path));
+}
+
+/* check the header against the files it lists, advance to the records */
+static bool static_arg_compgen_cache_valid(So *cache) {
+    if(so_cmp0(*cache, so(ARG_COMPGEN_CACHE_MAGIC))) return false;
+    *cache = so_i0(*cache, so_len(so(ARG_COMPGEN_CACHE_MAGIC)));
+    So expect = SO;
+    bool valid = true;
+    while(valid && so_len(*cache)) {
+        So line = so_split_ch(*cache, '\n', cache);
+        if(!so_len(line)) break;
+        So path = line;
+        for(size_t i = 0; i < 4; ++i) so_split_ch(path, ' ', &path);
+        so_clear(&expect);
+        static_arg_compgen_cache_stat(&expect, path);
+        valid = !so_cmp(so_iE(expect, so_len(expect) - 1), line);
+    }
+    so_free(&expect);
+    return valid;
+}
+
+static void static_arg_compgen_cache_key(So *out, struct Arg *arg) {
+    So path = SO;
+    so_extend(out, so(ARG_COMPGEN_CACHE_MAGIC));
+    static_arg_compgen_cache_stat(out, so("/proc/self/exe"));
+    for(size_t i = 0; i < array_len(arg->builtin.sources_vso); ++i) {
+        so_clear(&path);
+        so_extend_wordexp(&path, array_at(arg->builtin.sources_vso, i), false);
+        static_arg_compgen_cache_stat(out, path);
+    }
+    so_push(out, '\n');
+    so_free(&path);
+}
+
+static void static_arg_compgen_cache_record(So *out, char kind, So pre, So key, So values) {
+    so_push(out, kind);
+    static_arg_compgen_cache_word(out, pre, key, SO);
+    so_extend(out, values);
+    so_push(out, 0);
+}
+
+static void static_arg_compgen_cache_records(So *out, struct Arg *arg) {
+    So values = SO;
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        for(Argx *it = group->list; it; it = it->next) {
+            char kind = ARG_COMPGEN_CACHE_OPTION;
+            if(it == arg->help.argx) kind = ARG_COMPGEN_CACHE_HELP;
+            else if(it->id == ARGX_TYPE_REST) kind = ARG_COMPGEN_CACHE_REST;
+            else if(arg_parse_argx_n_values(it)) kind = ARG_COMPGEN_CACHE_TAKES;
+            so_clear(&values);
+            static_arg_compgen_values(&values, static_arg_compgen_cache_word, it);
+            if(!static_arg_compgen_taken(arg, group, it->opt, 0)) {
+                static_arg_compgen_cache_record(out, kind, so("--"), it->opt, values);
+            }
+            if(it->c && !static_arg_compgen_taken(arg, group, SO, it->c)) {
+                static_arg_compgen_cache_record(out, kind, so("-"), so_ll((char *)&it->c, 1), values);
+            }
+        }
+    }
+    size_t i_pos = 0;
+    for(Argx *it = arg->pos.list; it; it = it->next, ++i_pos) {
+        so_clear(&values);
+        if(!static_arg_compgen_values(&values, static_arg_compgen_cache_word, it)) continue;
+        So key = SO;
+        so_fmt(&key, "%zu", i_pos);
+        static_arg_compgen_cache_record(out, ARG_COMPGEN_CACHE_POSITIONAL, SO, key, values);
+        so_free(&key);
+    }
+    so_clear(&values);
+    static_arg_compgen_help_all(&values, static_arg_compgen_cache_word, arg);
+    static_arg_compgen_cache_record(out, ARG_COMPGEN_CACHE_HIERARCHY, SO, SO, values);
+    so_free(&values);
+}
+
+void arg_compgen_cache_write(struct Arg *arg) {
+    ASSERT_ARG(arg);
+    So path = arg->builtin.compgen_cache;
+    if(!so_len(path)) return;
+    So content = SO, cached = SO, tmp = SO;
+    static_arg_compgen_cache_key(&content, arg);
+    /* nothing changed since the last time */
+    if(!so_file_read(path, &cached) && !so_cmp0(cached, content)) goto defer;
+    /* the cache does not depend on the command line, so it covers every subcommand */
+    arg_subcommands_build(arg);
+    static_arg_compgen_cache_records(&content, arg);
+    /* write next to it and rename, so concurrent completions never read half a file */
+    so_fmt(&tmp, "%.*s.%ld", SO_F(path), (long)getpid());
+    so_push(&tmp, 0);
+    FILE *file = fopen(tmp.str, "wb");
+    if(!file) {
+        So dir = so_get_dir(path);
+        char cdir[PATH_MAX] = {0};
+        if(so_len(dir) < sizeof(cdir)) {
+            memcpy(cdir, dir.str, so_len(dir));
+            mkdir(cdir, 0700);
+        }
+        file = fopen(tmp.str, "wb");
+    }
+    if(!file) goto defer;
+    bool written = (fwrite(content.str, 1, so_len(content), file) == so_len(content));
+    written &= !fclose(file);
+    So dest = so_clone(path);
+    so_push(&dest, 0);
+    if(!written || rename(tmp.str, dest.str)) remove(tmp.str);
+    so_free(&dest);
+defer:
+    so_free(&content);
+    so_free(&cached);
+    so_free(&tmp);
+}
+
+/* next record; the candidates each end with a null character */
+static bool static_arg_compgen_cache_next(So *records, char *kind, So *key, So *list) {
+    if(!so_len(*records)) return false;
+    *kind = so_at0(*records);
+    *key = so_split_ch(so_i0(*records, 1), 0, records);
+    So rest = *records;
+    size_t len = 0;
+    while(so_len(rest) && so_at0(rest)) {
+        len += so_len(so_split_ch(rest, 0, &rest)) + 1;
+    }
+    *list = so_iE(*records, len);
+    *records = so_i0(rest, 1);
+    return true;
+}
+
+static bool static_arg_compgen_cache_find(So records, const char *kinds, So key, char *kind, So *list) {
+    So k = SO;
+    while(static_arg_compgen_cache_next(&records, kind, &k, list)) {
+        if(strchr(kinds, *kind) && !so_cmp(k, key)) return true;
+    }
+    return false;
+}
+
+/* same decisions as the static completion script */
+static void static_arg_compgen_cache_reply(So records, const int argc, const char **argv) {
+    So word = SO, key = SO, list = SO, taking = SO;
+    char kind = 0;
+    bool nfirst = false, takes = false, help = false, rest = false;
+    size_t n_pos = 0;
+    so_env_get(&word, so("COMPGEN_WORD"));
+    So value = static_arg_compgen_value(word);
+    /* the last argument is the word being completed, unless that is empty */
+    int n = so_len(word) ? argc - 1 : argc;
+    for(int i = 1; i < n && !help && !rest; ++i) {
+        So carg = so_l((char *)argv[i]);
+        if(takes) {
+            takes = false;
+            continue;
+        }
+        if(so_at0(carg) != '-' || so_len(carg) < 2) {
+            ++n_pos;
+            continue;
+        }
+        So opt = so_split_ch(carg, '=', 0);
+        if(!static_arg_compgen_cache_find(records, ARG_COMPGEN_CACHE_OPTIONS, opt, &kind, &list)) continue;
+        switch(kind) {
+            case ARG_COMPGEN_CACHE_HELP: help = true; break;
+            case ARG_COMPGEN_CACHE_REST: rest = true; break;
+            case ARG_COMPGEN_CACHE_TAKES: {
+                takes = (so_len(opt) == so_len(carg));
+                taking = opt;
+            } break;
+            default: break;
+        }
+    }
+    if(rest) {
+        return;
+    } else if(help) {
+        if(!static_arg_compgen_cache_find(records, "y", SO, &kind, &list)) return;
+        while(so_len(list)) {
+            So c = so_split_ch(list, 0, &list);
+            /* help topics: one level at a time */
+            if(so_cmp0(c, value)) continue;
+            So sub = so_i0(c, so_len(value));
+            if(so_atE(sub) == '.') sub = so_iE(sub, so_len(sub) - 1);
+            if(so_find_ch(sub, '.') < so_len(sub)) continue;
+            if(so_len(c) == so_len(value) && so_atE(c) == '.') continue;
+            static_arg_compgen_emit(&nfirst, value, SO, c, SO);
+        }
+    } else if(takes || so_len(value) != so_len(word)) {
+        if(!takes) taking = so_split_ch(word, '=', 0);
+        if(!static_arg_compgen_cache_find(records, ARG_COMPGEN_CACHE_OPTIONS, taking, &kind, &list)) return;
+        while(so_len(list)) {
+            static_arg_compgen_emit(&nfirst, value, SO, so_split_ch(list, 0, &list), SO);
+        }
+    } else if(so_at0(word) == '-') {
+        while(static_arg_compgen_cache_next(&records, &kind, &key, &list)) {
+            if(!strchr(ARG_COMPGEN_CACHE_OPTIONS, kind)) continue;
+            static_arg_compgen_emit(&nfirst, value, SO, key, SO);
+        }
+    } else {
+        char index[32];
+        snprintf(index, sizeof(index), "%zu", n_pos);
+        if(!static_arg_compgen_cache_find(records, "p", so_l(index), &kind, &list)) return;
+        while(so_len(list)) {
+            static_arg_compgen_emit(&nfirst, value, SO, so_split_ch(list, 0, &list), SO);
+        }
+    }
+}
+
+bool arg_compgen_cached(const int argc, const char **argv) {
+    So wordlist = SO, path = SO, cache = SO;
+    bool compgen = false;
+    so_env_get(&wordlist, so("COMPGEN_WORDLIST"));
+    so_env_get(&path, so("COMPGEN_CACHE"));
+    if(so_as_yes_or_no(wordlist, &compgen) || !compgen || !so_len(path)) return false;
+    if(so_file_read(path, &cache)) return false;
+    So records = cache;
+    bool valid = static_arg_compgen_cache_valid(&records);
+    if(valid) {
+        static_arg_compgen_cache_reply(records, argc, argv);
+        fflush(stdout);
     }
-    printf("%c%.*s.", ARG_COMPGEN_DELIM, SO_F(arg->pos.name));
-    printf("%c%.*s.", ARG_COMPGEN_DELIM, SO_F(arg->env.name));
+    so_free(&cache);
+    return valid;
 }
 
+/* completion cache }}} */
 
@@ -13,6 +13,8 @@ void arg_compgen_help_argx(struct Arg *arg, struct Argx *argx);
 void arg_compgen_help_group(struct Arg *arg, struct Argx_Group *group);
 void arg_compgen_help_groups(struct Arg *arg);
 
+void arg_compgen_cache_write(struct Arg *arg);
+
 #define ARG_COMPGEN_H
 #endif /* ARG_COMPGEN_H */
 
@@ -6,12 +6,19 @@ void arg_free(struct Arg **parg) {
     if(!parg) return;
     Arg *arg = *parg;
     if(!arg) return;
-    array_free_ext(arg->opts, argx_groups_free);
+    for(Argx_Group *group = arg->opts, *next; group; group = next) {
+        next = group->next;
+        argx_group_free(group);
+        if(!arg->config.storage.buf) free(group);
+    }
     argx_group_free(&arg->pos);
     argx_group_free(&arg->env);
     array_free(arg->queue);
+    array_free(arg->env_found);
+    array_free(arg->env_prefixed);
     vso_free(&arg->builtin.sources_paths);
     vso_free(&arg->builtin.sources_content);
+    array_free(arg->builtin.sources_default);
     vso_free(&arg->help.sub);
     so_al_cache_free(&arg->print.p_al2);
     so_free(&arg->builtin.custom_err_msg);
@@ -19,6 +26,37 @@ void arg_free(struct Arg **parg) {
     *parg = 0;
 }
 
+void arg_reset(struct Arg *arg) {
+    ASSERT_ARG(arg);
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        argx_group_reset(group);
+    }
+    argx_group_reset(&arg->pos);
+    argx_group_reset(&arg->env);
+    array_extend(arg->builtin.sources_vso, arg->builtin.sources_default);
+    arg->i_pos = 0;
+    arg->pos_next = 0;
+    arg->subcommand = 0;
+    array_free(arg->queue);
+    arg_parse_dirty_flags_clear(arg);
+    array_free(arg->env_found);
+    array_free(arg->env_prefixed);
+    vso_free(&arg->builtin.sources_paths);
+    vso_free(&arg->builtin.sources_content);
+    vso_free(&arg->help.sub);
+    so_free(&arg->builtin.custom_err_msg);
+    arg->help.last = 0;
+    arg->help.error = 0;
+    arg->help.wanted = false;
+    arg->print.compgen_nfirst = false;
+    arg->builtin.quit_early = false;
+    arg->builtin.quit_when_all_parsed = false;
+    arg->builtin.compgen_flags = false;
+    arg->builtin.compgen_done = false;
+    arg->builtin.config_print_selected = false;
+    arg->builtin.error_id = ARG_PARSE_ERROR_NONE;
+}
+
 void arg_init_al(Arg_Rice *rice, struct Arg *arg, So_Align_Cache *alc, bool no_default) {
 
 #define RLARG_SO_AL_CFG(x, no_default, a, b, c, d, alc) do { \
@@ -77,8 +115,6 @@ void arg_init_al(Arg_Rice *rice, struct Arg *arg, So_Align_Cache *alc, bool no_d
 struct Arg *arg_new(Arg_Config *cfg) {
     Arg *result;
     NEW(Arg, result);
-    result->pos = argx_group_init(result, &result->t_pos, so("positional"), ARGX_GROUP_ROOT, 0);
-    result->env = argx_group_init(result, &result->t_env, so("environment"), ARGX_GROUP_ROOT, 0);
 
     Arg_Config *free_cfg = 0;
     if(!cfg) {
@@ -87,6 +123,9 @@ struct Arg *arg_new(Arg_Config *cfg) {
     }
 
     result->config = *cfg;
+    bool storage = (bool)cfg->storage.buf;
+    result->pos = argx_group_init(result, storage ? 0 : &result->t_pos, so("positional"), ARGX_GROUP_ROOT, 0);
+    result->env = argx_group_init(result, storage ? 0 : &result->t_env, so("environment"), ARGX_GROUP_ROOT, 0);
     arg_init_al(&result->rice, result, &result->print.p_al2, false);
 
     arg_config_free(&free_cfg);
@@ -107,8 +146,8 @@ void arg_help(struct Arg *arg) {
     if(have_prog || have_desc) so_al_nl(&out, arg->rice.whitespace, 1);
 
     argx_group_fmt_help(&out, &arg->pos);
-    for(Argx_Group **group = arg->opts; group < array_itE(arg->opts); ++group) {
-        argx_group_fmt_help(&out, *group);
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        argx_group_fmt_help(&out, group);
     }
     argx_group_fmt_help(&out, &arg->env);
 
@@ -127,10 +166,9 @@ void arg_help_short(struct Arg *arg) {
     /* format long options */
     so_al_cache_clear(&arg->print.p_al2);
     so_fmt(&out, "Options:\n");
-    for(Argx_Group **group = arg->opts; group < array_itE(arg->opts); ++group) {
-        Argx **xE = array_itE((*group)->list);
-        for(Argx **xI = (*group)->list; xI < xE; ++xI) {
-            so_fmt_fx(&out, arg->rice.opt, 0, "--%.*s", SO_F((*xI)->opt));
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        for(Argx *x = group->list; x; x = x->next) {
+            so_fmt_fx(&out, arg->rice.opt, 0, "--%.*s", SO_F(x->opt));
             so_fmt_al(&out, arg->rice.whitespace, 0, " ");
         }
     }
@@ -139,11 +177,10 @@ void arg_help_short(struct Arg *arg) {
     so_al_cache_clear(&arg->print.p_al2);
     so_fmt(&out, "\n\nShort options:\n");
     so_fmt_fx(&out, arg->rice.opt, 0, "-");
-    for(Argx_Group **group = arg->opts; group < array_itE(arg->opts); ++group) {
-        Argx **xE = array_itE((*group)->list);
-        for(Argx **xI = (*group)->list; xI < xE; ++xI) {
-            if((*xI)->c) {
-                so_fmt_fx(&out, arg->rice.opt, 0, "%c", (*xI)->c);
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        for(Argx *x = group->list; x; x = x->next) {
+            if(x->c) {
+                so_fmt_fx(&out, arg->rice.opt, 0, "%c", x->c);
             }
         }
     }
@@ -224,6 +261,9 @@ void argx_extend_sources(Arg_Stream_Source **srces, Argx *argx) {
     ASSERT_ARG(argx->group_p);
     ASSERT_ARG(argx->group_p->arg);
 
+    if(argx->source.id) {
+        array_push(*srces, argx->source);
+    }
     size_t len = array_len(argx->sources);
     if(len) {
         for(size_t i = 0; i < len; ++i) {
@@ -253,13 +293,15 @@ void arg_help_argx(struct Argx *help) {
 
     arg_help_argx_rec(&out, help, full_help);
     if(help->id == ARGX_TYPE_GROUP) {
-        ASSERT_ARG(help->group_s);
-        Argx **itE = array_itE(help->group_s->list);
-        for(Argx **it = help->group_s->list; it < itE; ++it) {
+        Argx_Group *sub = argx_group_sub(help);
+        ASSERT_ARG(sub);
+        for(Argx *it = sub->list; it; it = it->next) {
             so_fmt_fx(&out, rice->opt, 0, "\n");
-            argx_fmt_help(&out, *it, true);
-            argx_extend_sources(&sources, *it);
+            argx_fmt_help(&out, it, true);
+            argx_extend_sources(&sources, it);
         }
+        /* a flag mask keeps the sources itself */
+        if(sub->is_bitmask) argx_extend_sources(&sources, help);
     } else {
         argx_extend_sources(&sources, help);
     }
@@ -295,7 +337,18 @@ void arg_help_argx(struct Argx *help) {
         So source_hierarchy = SO;
         if(!help->attr.is_unconfigurable) {
             so_fmt(&out, "\nsources:\n");
-            if(!array_len(sources)) {
+            Argx_So_Map *map = help->attr.is_map && help->val.map ? *help->val.map : 0;
+            if(argx_so_map_len(map)) {
+                /* each key keeps where it was set */
+                argx_so_hierarchy(&source_hierarchy, &dummy, help->group_p);
+                for(size_t i = 0; i < argx_so_map_len(map); ++i) {
+                    Argx_So_Map_Item *item = array_it(map->list, i);
+                    so_extend(&out, so("  "));
+                    arg_stream_source_so(&out, &item->source);
+                    so_fmt(&out, "   ( %.*s%.*s[%.*s] )", SO_F(source_hierarchy), SO_F(help->opt), SO_F(item->key));
+                    if(i + 1 < argx_so_map_len(map)) so_extend(&out, so(",\n"));
+                }
+            } else if(!array_len(sources)) {
                 so_fmt(&out, "  not set anywhere");
             } else {
                 Arg_Stream_Source *itE = array_itE(sources);
@@ -330,9 +383,9 @@ void arg_enable_config_print(struct Arg *arg, bool enable) {
 void arg_config(struct Arg *arg) {
     ASSERT_ARG(arg);
     So out = SO;
-    for(Argx_Group **group = arg->opts; group < array_itE(arg->opts); ++group) {
-        if(!(*group)->config_print) continue;
-        argx_group_fmt_config(&out, *group);
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        if(!group->config_print) continue;
+        argx_group_fmt_config(&out, group);
     }
     so_print(out);
     so_free(&out);
@@ -384,6 +437,73 @@ void arg_config_set_width(struct Arg_Config *cfg, size_t width) {
     cfg->bounds.max = width;
 }
 
+void arg_config_set_storage(struct Arg_Config *cfg, void *storage, size_t n_argx, size_t n_group) {
+    ASSERT_ARG(cfg);
+    ASSERT_ARG(storage);
+    cfg->storage.buf = storage;
+    cfg->storage.n_argx = n_argx;
+    cfg->storage.n_group = n_group;
+}
+
+void arg_config_set_lazy(struct Arg_Config *cfg, bool lazy) {
+    ASSERT_ARG(cfg);
+    cfg->lazy = lazy;
+}
+
+void arg_config_set_layered(struct Arg_Config *cfg, bool layered) {
+    ASSERT_ARG(cfg);
+    cfg->layered = layered;
+}
+
+void arg_config_set_env_prefix(struct Arg_Config *cfg, So prefix) {
+    ASSERT_ARG(cfg);
+    cfg->env_prefix = prefix;
+}
+
+void arg_config_set_parallel_workers(struct Arg_Config *cfg, size_t n) {
+    ASSERT_ARG(cfg);
+    cfg->parallel_workers = n;
+}
+
+_Static_assert(sizeof(Argx) <= ARG_STORAGE_ARGX_SIZE, "increase ARG_STORAGE_ARGX_SIZE");
+_Static_assert(sizeof(Argx_Group) <= ARG_STORAGE_GROUP_SIZE, "increase ARG_STORAGE_GROUP_SIZE");
+
+Argx *arg_storage_argx(struct Arg *arg) {
+    ASSERT_ARG(arg);
+    if(!arg->config.storage.buf) return 0;
+    if(arg->storage.n_argx >= arg->config.storage.n_argx) {
+        ABORT("storage exhausted, can only register %zu arguments", arg->config.storage.n_argx);
+    }
+    unsigned char *slot = arg->config.storage.buf + ARG_STORAGE_ARGX_SIZE * arg->storage.n_argx++;
+    Argx *result = (Argx *)slot;
+    memset(result, 0, sizeof(*result));
+    return result;
+}
+
+/* in order of registration, linked through the argx itself so nothing gets allocated */
+void arg_required_push(struct Arg *arg, Argx *argx) {
+    ASSERT_ARG(arg);
+    ASSERT_ARG(argx);
+    if(argx->required_next || arg->required_last == argx) return;
+    if(arg->required_last) arg->required_last->required_next = argx;
+    else arg->required = argx;
+    arg->required_last = argx;
+}
+
+Argx_Group *arg_storage_group(struct Arg *arg) {
+    ASSERT_ARG(arg);
+    if(!arg->config.storage.buf) return 0;
+    if(arg->storage.n_group >= arg->config.storage.n_group) {
+        ABORT("storage exhausted, can only register %zu groups", arg->config.storage.n_group);
+    }
+    unsigned char *slot = arg->config.storage.buf
+        + ARG_STORAGE_ARGX_SIZE * arg->config.storage.n_argx
+        + ARG_STORAGE_GROUP_SIZE * arg->storage.n_group++;
+    Argx_Group *result = (Argx_Group *)slot;
+    memset(result, 0, sizeof(*result));
+    return result;
+}
+
 void arg_config_free(struct Arg_Config **pcfg) {
     if(!pcfg) return;
     Arg_Config *cfg = *pcfg;
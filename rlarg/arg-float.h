@@ -0,0 +1,15 @@
+#ifndef ARG_FLOAT_H
+
+#include <rlso.h>
+
+/* correctly rounded and independent of the locale: exact short values take
+ * the fast path, Eisel-Lemire the rest, a big decimal if that can't decide */
+int arg_float_as_double(So so, double *out);
+int arg_float_as_float(So so, float *out);
+
+/* shortest text that converts back to the same value, with a '.' in any locale */
+void arg_float_fmt_double(So *out, double val);
+void arg_float_fmt_float(So *out, float val);
+
+#define ARG_FLOAT_H
+#endif /* ARG_FLOAT_H */
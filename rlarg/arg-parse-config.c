@@ -44,6 +44,10 @@ int arg_parse_config_assign_file_named(Arg_Parse_Config *p, So path, bool in_arr
     } else {
         so_path_join(&p->tmp_file_path, so_get_dir(p->stream.source.path), path);
     }
+    if(!in_array && argx_is_configurable(p->argx) && arg_parse_argx_is_deferred(p->arg, p->argx)) {
+        arg_parse_argx_defer(p->arg, &p->stream, p->argx, SO, p->tmp_file_path);
+        return 0;
+    }
     /* read file */
     //printff("FILE NAMED %.*s", SO_F(p->tmp_file_path));
     if(so_file_read(p->tmp_file_path, &content)) {
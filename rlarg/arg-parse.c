@@ -2,7 +2,9 @@
 #include "arg-parse.h"
 #include "arg.h"
 #include "arg-compgen.h"
+#include "arg-float.h"
 #include <unistd.h>
+#include <ctype.h>
 
 int arg_parse_positional(struct Arg *arg, Arg_Stream *stream, Argx *argx);
 
@@ -75,6 +77,7 @@ void arg_parse_error(Arg *arg, Arg_Stream *stream, Arg_Parse_Error_List id, Argx
         //        || id == ARG_PARSE_ERROR_INVALID_OPTION_GROUP
         //        || id == ARG_PARSE_ERROR_INVALID_OPTION_ROOT)) {
         stream->error_id = id;
+        if(!arg->builtin.error_id) arg->builtin.error_id = id;
         switch(id) {
             case ARG_PARSE_ERROR_HIERARCHY_ROOT_CONFIG: /* pseudo */
             case ARG_PARSE_ERROR_HIERARCHY_TABLE_CONFIG: /* pseudo */
@@ -97,6 +100,7 @@ void arg_parse_error(Arg *arg, Arg_Stream *stream, Arg_Parse_Error_List id, Argx
             } break;
             case ARG_PARSE_ERROR_UNCONFIGURABLE:
             case ARG_PARSE_ERROR_INVALID_CONVERSION:
+            case ARG_PARSE_ERROR_DUPLICATE_KEY:
             case ARG_PARSE_ERROR_INVALID_OPTION_GROUP:
             case ARG_PARSE_ERROR_MISSING_SEQUENCE:
             case ARG_PARSE_ERROR_MISSING_POSITIONAL:
@@ -113,7 +117,7 @@ void arg_parse_error(Arg *arg, Arg_Stream *stream, Arg_Parse_Error_List id, Argx
             } break;
             default: ABORT(ERR_UNREACHABLE("unhandled id: %u"), id);
         }
-        if(!arg->builtin.compgen) {
+        if(!arg->builtin.compgen && !arg->builtin.batch) {
             /* TODO: just use arg_stream_source_so ... */
             switch(stream->source.id) {
                 default: break;
@@ -147,6 +151,9 @@ void arg_parse_error(Arg *arg, Arg_Stream *stream, Arg_Parse_Error_List id, Argx
                 case ARG_PARSE_ERROR_INVALID_CONVERSION: {
                     FFF(c, nc, "Invalid conversion for '%.*s' %.*s: %.*s", FG_RD_B BOLD, SO_F(argx->opt), SO_F(hint), SO_F(stream->carg));
                 } break;
+                case ARG_PARSE_ERROR_DUPLICATE_KEY: {
+                    FFF(c, nc, "Duplicate key for '%.*s': %.*s", FG_RD_B BOLD, SO_F(argx->opt), SO_F(stream->carg));
+                } break;
                 case ARG_PARSE_ERROR_INVALID_OPTION_GROUP: {
                     FFF(c, nc, "Option not found in '%.*s' %.*s: %.*s", FG_RD_B BOLD, SO_F(argx->opt), SO_F(hint), SO_F(stream->carg));
                 } break;
@@ -210,8 +217,8 @@ void arg_parse_error(Arg *arg, Arg_Stream *stream, Arg_Parse_Error_List id, Argx
                 case ARG_PARSE_ERROR_UNHANDLED_POSITIONAL: {
                     FFF(c, nc, "Unknown error occured while parsing: ", FG_RD_B BOLD);
                     if(!so_len(c)) {
-                        while(stream->i < array_len(stream->vso)) {
-                            So carg = array_at(stream->vso, stream->i);
+                        while(stream->i < arg_stream_len(stream)) {
+                            So carg = arg_stream_at(stream, stream->i);
                             fprintf(stderr, "%.*s ", SO_F(carg));
                             ++stream->i;
                         }
@@ -220,8 +227,8 @@ void arg_parse_error(Arg *arg, Arg_Stream *stream, Arg_Parse_Error_List id, Argx
                 case ARG_PARSE_ERROR_NO_REST_ALLOWED: {
                     FFF(c,nc, "Not allowed to set rest of values: ", FG_RD_B BOLD);
                     if(!so_len(c)) {
-                        while(stream->i < array_len(stream->vso)) {
-                            So carg = array_at(stream->vso, stream->i);
+                        while(stream->i < arg_stream_len(stream)) {
+                            So carg = arg_stream_at(stream, stream->i);
                             fprintf(stderr, "%.*s ", SO_F(carg));
                             ++stream->i;
                         }
@@ -247,6 +254,7 @@ Argx *arg_parse_get_shortopt(struct Arg *arg, char c) {
     Argx *result = 0;
     if(c >= ARGX_SHORT_MIN && c < ARGX_SHORT_MAX) {
         result = arg->c[c - ARGX_SHORT_MIN];
+        if(!result && arg->subcommand) result = argx_group_get_short(arg->subcommand, c);
     }
     return result;
 }
@@ -259,22 +267,30 @@ void arg_parse_add_source(struct Argx *argx, Arg_Stream_Source source) {
     source.argx = argx;
     if(source.id == ARG_STREAM_SOURCE_CONFIG) {
         source.path = so_clone(source.path);
+    }
+    if(argx->attr.is_array) {
         array_push(argx->sources, source);
     } else {
-        array_push(argx->sources, source);
+        arg_stream_source_free(&argx->source);
+        argx->source = source;
     }
 }
 
+/* one record for consecutive values of the same source, e.g. an array in a config */
+static void static_arg_parse_add_source_packed(Argx *argx, Arg_Stream_Source src) {
+    size_t n = array_len(argx->sources);
+    Arg_Stream_Source *last = n ? array_it(argx->sources, n - 1) : 0;
+    if(!last || last->id != src.id || so_cmp(last->path, src.path)) arg_parse_add_source(argx, src);
+}
+
 int arg_parse_sequence(struct Arg *arg, Arg_Stream *stream, Argx *argx) {
     ASSERT_ARG(arg);
     ASSERT_ARG(stream);
     int status = 0;
-    size_t i_pos = 0;
     So carg = SO;
 
-    size_t len = array_len(argx->group_s->list);
-    while(i_pos < len) {
-        Argx *pos = array_at(argx->group_s->list, i_pos);
+    Argx *pos = argx->group_s->list;
+    while(pos) {
         //printff("GOT SEQUENTIAL ARGX: %.*s", SO_F(pos->opt));
         if(!arg_stream_get_next(stream, &carg, &arg->builtin.compgen_flags)) {
             arg_parse_error(arg, stream, ARG_PARSE_ERROR_MISSING_SEQUENCE, pos);
@@ -286,7 +302,7 @@ int arg_parse_sequence(struct Arg *arg, Arg_Stream *stream, Argx *argx) {
             status = -1;
             break;
         } else {
-            ++i_pos;
+            pos = pos->next;
         }
     }
 
@@ -295,15 +311,59 @@ int arg_parse_sequence(struct Arg *arg, Arg_Stream *stream, Argx *argx) {
 
 /* coarse parsers {{{ */
 
+/* like the bool flags, the first explicit assignment replaces the default */
+static void static_arg_parse_setval_mask(Argx *argx, uint64_t set, uint64_t clear, bool replace, Arg_Stream_Source src) {
+    if(argx->val.mask) {
+        uint64_t mask = (replace || !argx_is_explicit(argx)) ? 0 : *argx->val.mask;
+        *argx->val.mask = (mask & ~clear) | set;
+    }
+    arg_parse_add_source(argx, src);
+}
+
+/* the whole list becomes one set and one clear mask; with any flag without a sign, argv replaces what was set before */
+static int static_arg_parse_group_mask(struct Arg *arg, Arg_Stream *stream, Argx *argx, Argx_Group *sub, So so) {
+    uint64_t set = 0, clear = 0;
+    bool replace = false;
+    bool any = false;
+    for(So so_split = SO; so_splice(so, &so_split, ','); ) {
+        char sign = so_at0(so_split);
+        if(sign == '+' || sign == '-') {
+            so_split = so_i0(so_split, 1);
+        } else {
+            replace |= (stream->source.id == ARG_STREAM_SOURCE_STDIN);
+        }
+        Argx *subx = argx_group_get(sub, so_split);
+        if(!subx) {
+            arg_parse_error(arg, stream, ARG_PARSE_ERROR_INVALID_OPTION_GROUP, argx);
+            return -1;
+        }
+        arg_parse_set_help_any(arg, subx);
+        uint64_t bit = (uint64_t)1 << subx->attr.val_enum;
+        if(sign == '-') {
+            clear |= bit;
+            set &= ~bit;
+        } else {
+            set |= bit;
+            clear &= ~bit;
+        }
+        any = true;
+    }
+    if(!any) return -1;
+    static_arg_parse_setval_mask(argx, set, clear, replace, stream->source);
+    return 0;
+}
+
 int arg_parse_group(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
+    Argx_Group *sub = argx_group_sub(argx);
+    if(sub && sub->is_bitmask) return static_arg_parse_group_mask(arg, stream, argx, sub, so);
     So so_split = SO;
     So flagv = SO;
     int result = -1;
     bool done = false;
     do {
         Argx *subx = 0;
-        ASSERT_ARG(argx->group_s);
-        if(argx->group_s->id == ARGX_GROUP_FLAGS) {
+        ASSERT_ARG(sub);
+        if(sub->id == ARGX_GROUP_FLAGS) {
             if(!so_splice(so, &so_split, ',')) break;
 #if 0
             flagv = so("1"); // TODO: this is so stupid
@@ -321,19 +381,19 @@ int arg_parse_group(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
                 so_split = so_i0(so_split, 1);
             }
 #endif
-        } else if(argx->group_s->id == ARGX_GROUP_SEQUENCE) {
+        } else if(sub->id == ARGX_GROUP_SEQUENCE) {
             arg_stream_not_consumed(stream);
             result = arg_parse_sequence(arg, stream, argx);
             break; /* quit to loop */
         } else {
             so_split = so;
         }
-        subx = t_argx_get(argx->group_s->table, so_split);
+        subx = argx_group_get(sub, so_split);
         if(subx) {
             //printff("GOT SUBX %.*s",SO_F(subx->opt));
             if(subx->id != ARGX_TYPE_NONE) {
                 arg_parse_set_help_any(arg, subx);
-                switch(argx->group_s->id) {
+                switch(sub->id) {
                     case ARGX_GROUP_ENUM: {
                         result = arg_parse_argx(arg, stream, subx, SO);
                         done = true;
@@ -400,6 +460,13 @@ int arg_parse_argx_vso(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
     return 0;
 }
 
+/* straight into the container of the user */
+int arg_parse_argx_vcustom(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
+    int result = argx->custom.type->convert(argx->val.any, so, argx->custom.user);
+    if(!result) static_arg_parse_add_source_packed(argx, stream->source);
+    return result;
+}
+
 int arg_parse_argx_vcolor(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
     Color v;
     int result = so_as_color(so, &v);
@@ -418,7 +485,8 @@ int arg_parse_argx_bool(Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
         arg_parse_setval_argx(argx, &(Argx_Value_Union){ .b = &v }, stream->source, false);
     } else {
         if(!stream->is_config && !argx_attr_is_explicit_bool(argx)) {
-            v = argx->val.b ? !*argx->val.b : true;
+            /* toggle what was set before, not the reference */
+            v = argx->val.b && argx_is_explicit(argx) ? !*argx->val.b : true;
             arg_parse_setval_argx(argx, &(Argx_Value_Union){ .b = &v }, stream->source, false);
             arg_stream_not_consumed(stream);
             result = 0;
@@ -441,12 +509,37 @@ int arg_parse_argx_size(Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
     return result;
 }
 
+int arg_parse_argx_double(Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
+    double v;
+    int result = arg_float_as_double(so, &v);
+    if(!result) arg_parse_setval_argx(argx, &(Argx_Value_Union){ .d = &v }, stream->source, false);
+    return result;
+}
+
+int arg_parse_argx_float(Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
+    float v;
+    int result = arg_float_as_float(so, &v);
+    if(!result) arg_parse_setval_argx(argx, &(Argx_Value_Union){ .f = &v }, stream->source, false);
+    return result;
+}
+
 int arg_parse_argx_so(Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
     arg_parse_setval_argx(argx, &(Argx_Value_Union){ .so = &so }, stream->source, false);
     arg_parse_setval_argx_callback_refval_single(argx, stream->source, so);
     return 0;
 }
 
+/* straight into the value; setval only has to record the source */
+int arg_parse_argx_custom(Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
+    /* convert into a copy, an invalid value must not leave the bound one half written */
+    size_t size = argx->custom.type->size;
+    max_align_t scratch[size / sizeof(max_align_t) + 1];
+    if(argx->val.any) memcpy(scratch, argx->val.any, size);
+    int result = argx->custom.type->convert(scratch, so, argx->custom.user);
+    if(!result) arg_parse_setval_argx(argx, &(Argx_Value_Union){ .any = scratch }, stream->source, false);
+    return result;
+}
+
 int arg_parse_argx_color(Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
     Color v;
     int result = so_as_color(so, &v);
@@ -458,6 +551,8 @@ int arg_parse_argx_color(Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
 int arg_parse_argx_enum(Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
     ASSERT_ARG(so_is_zero(so));
     arg_parse_setval_argx(argx, &(Argx_Value_Union){ .i = &argx->attr.val_enum }, stream->source, false);
+    Argx_Group *subcommand = argx_group_subcommand(argx);
+    if(subcommand) arg->subcommand = subcommand;
     return 0;
 }
 
@@ -485,29 +580,27 @@ int arg_parse_argx_flag(Arg *arg, Arg_Stream *stream, Argx *argx, So so_in) {
         if(stream->source.id == ARG_STREAM_SOURCE_STDIN) {
             bool reset_related = false;
             Argx_Group *related = argx->group_p;
-            Argx **itE = array_itE(related->list);
-            for(Argx **it = related->list; it < itE; ++it) {
-                Arg_Stream_Source *jtE = array_itE((*it)->sources);
-                for(Arg_Stream_Source *jt = (*it)->sources; jt < jtE; ++jt) {
+            for(Argx *it = related->list; it; it = it->next) {
+                Arg_Stream_Source *jt = &it->source;
+                if(!jt->id || jt->id == ARG_STREAM_SOURCE_REFVAL) continue;
 #if 1
-                    reset_related = true;
+                reset_related = true;
 #else
-                    if(jt->id == ARG_STREAM_SOURCE_CONFIG ||
-                       jt->id == ARG_STREAM_SOURCE_REFVAL) {
-                        reset_related = true;
-                    } else if(jt->id == ARG_STREAM_SOURCE_STDIN) {
-                        reset_related = false;
-                        goto break2;
-                    }
-#endif
+                if(jt->id == ARG_STREAM_SOURCE_CONFIG ||
+                   jt->id == ARG_STREAM_SOURCE_REFVAL) {
+                    reset_related = true;
+                } else if(jt->id == ARG_STREAM_SOURCE_STDIN) {
+                    reset_related = false;
+                    goto break2;
                 }
+#endif
             }
             break2:;
             /* now reset, if need */
             if(reset_related) {
                 bool off = false;
-                for(Argx **it = related->list; it < itE; ++it) {
-                    arg_parse_setval_argx(*it, &(Argx_Value_Union){ .b = &off }, (Arg_Stream_Source){
+                for(Argx *it = related->list; it; it = it->next) {
+                    arg_parse_setval_argx(it, &(Argx_Value_Union){ .b = &off }, (Arg_Stream_Source){
                             .id = ARG_STREAM_SOURCE_FORCED, .number = stream->i, .path = argx->opt, }, false);
                 }
             }
@@ -601,6 +694,50 @@ int arg_parse_argx_vector_none(struct Arg *arg, Arg_Stream *stream, Argx *argx,
     return 0;
 }
 
+/* the bulk converter gets all of [a,b,...] at once */
+int arg_parse_argx_vector_custom(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so, Arg_Parse_Argx_Callback cb) {
+    const Argx_Type *type = argx->custom.type;
+    if(!type->convert_array) return arg_parse_argx_vector(arg, stream, argx, so, cb);
+    int result = type->convert_array(argx->val.any, so_trim(so), argx->custom.user);
+    if(!result) static_arg_parse_add_source_packed(argx, stream->source);
+    return result;
+}
+
+/* all of [a,b,...] converted first, then appended with one record of the source */
+int arg_parse_argx_vector_double(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so, Arg_Parse_Argx_Callback cb) {
+    double *v = 0, d;
+    int result = 0;
+    if(so_at0(so) == '[' && so_atE(so) == ']') {
+        so = so_sub(so, 1, so_len(so) - 1);
+        for(So sp = SO; so_splice(so, &sp, ','); ) {
+            if((result = arg_float_as_double(so_trim(sp), &d))) break;
+            array_push(v, d);
+        }
+    } else if(!(result = arg_float_as_double(so_trim(so), &d))) {
+        array_push(v, d);
+    }
+    if(!result) arg_parse_setval_argx(argx, &(Argx_Value_Union){ .vd = &v }, stream->source, false);
+    array_free(v);
+    return result;
+}
+
+int arg_parse_argx_vector_float(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so, Arg_Parse_Argx_Callback cb) {
+    float *v = 0, f;
+    int result = 0;
+    if(so_at0(so) == '[' && so_atE(so) == ']') {
+        so = so_sub(so, 1, so_len(so) - 1);
+        for(So sp = SO; so_splice(so, &sp, ','); ) {
+            if((result = arg_float_as_float(so_trim(sp), &f))) break;
+            array_push(v, f);
+        }
+    } else if(!(result = arg_float_as_float(so_trim(so), &f))) {
+        array_push(v, f);
+    }
+    if(!result) arg_parse_setval_argx(argx, &(Argx_Value_Union){ .vf = &v }, stream->source, false);
+    array_free(v);
+    return result;
+}
+
 int arg_parse_argx_vector_rest(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so, Arg_Parse_Argx_Callback cb) {
 
 #if 0
@@ -652,6 +789,9 @@ static Arg_Parse_Argx_Callback static_parse_argx_single_cbs[ARGX_TYPE__COUNT] =
     [ARGX_TYPE_STRING] = arg_parse_argx_so,
     [ARGX_TYPE_COLOR] = arg_parse_argx_color,
     [ARGX_TYPE_SWITCH] = arg_parse_argx_switch,
+    [ARGX_TYPE_CUSTOM] = arg_parse_argx_custom,
+    [ARGX_TYPE_DOUBLE] = arg_parse_argx_double,
+    [ARGX_TYPE_FLOAT] = arg_parse_argx_float,
     [ARGX_TYPE_REST] = 0,
 };
 
@@ -663,7 +803,10 @@ static Arg_Parse_Argx_Callback static_parse_argx_vector_vals_cbs[ARGX_TYPE__COUN
     [ARGX_TYPE_STRING] = arg_parse_argx_vso,
     [ARGX_TYPE_COLOR] = arg_parse_argx_vcolor,
     [ARGX_TYPE_REST] = arg_parse_argx_vso,
+    [ARGX_TYPE_CUSTOM] = arg_parse_argx_vcustom,
     [ARGX_TYPE_NONE] = 0,
+    [ARGX_TYPE_DOUBLE] = 0,
+    [ARGX_TYPE_FLOAT] = 0,
     [ARGX_TYPE_ENUM] = 0,
     [ARGX_TYPE_FLAG] = 0,
     [ARGX_TYPE_GROUP] = 0,
@@ -678,6 +821,9 @@ static Arg_Parse_Argx_Vector_Callback static_parse_argx_vector_cbs[ARGX_TYPE__CO
     [ARGX_TYPE_COLOR] = arg_parse_argx_vector,
     [ARGX_TYPE_NONE] = arg_parse_argx_vector_none,
     [ARGX_TYPE_REST] = arg_parse_argx_vector_rest,
+    [ARGX_TYPE_CUSTOM] = arg_parse_argx_vector_custom,
+    [ARGX_TYPE_DOUBLE] = arg_parse_argx_vector_double,
+    [ARGX_TYPE_FLOAT] = arg_parse_argx_vector_float,
     [ARGX_TYPE_ENUM] = 0,
     [ARGX_TYPE_FLAG] = 0,
     [ARGX_TYPE_GROUP] = 0,
@@ -687,16 +833,145 @@ static Arg_Parse_Argx_Vector_Callback static_parse_argx_vector_cbs[ARGX_TYPE__CO
 
 /* main parsing section {{{ */
 
-int arg_parse_argx(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
-    ASSERT_ARG(arg);
-    ASSERT_ARG(stream);
-    ASSERT_ARG(argx);
-    //printff("PARSE: %.*s <== '%.*s'",SO_F(argx->opt), SO_F(so));
+static bool static_arg_parse_is_lazy(struct Arg *arg, Argx *argx) {
+    return arg->config.lazy || argx->attr.is_lazy;
+}
+
+/* only the last assignment of a scalar matters; callbacks that load something right away have to see every one */
+static bool static_arg_parse_is_layered(struct Arg *arg, Argx *argx) {
+    if(!arg->config.layered || argx->attr.is_array) return false;
+    if(argx->callback.func && argx->callback.priority == ARGX_PRIORITY_IMMEDIATELY) return false;
+    return true;
+}
+
+/* only values that don't decide how much of the stream gets consumed */
+bool arg_parse_argx_is_deferred(struct Arg *arg, Argx *argx) {
+    if(!static_arg_parse_is_lazy(arg, argx) && !static_arg_parse_is_layered(arg, argx)) return false;
+    switch(argx->id) {
+        case ARGX_TYPE_BOOL: return argx->attr.is_array;
+        case ARGX_TYPE_INT:
+        case ARGX_TYPE_SIZE:
+        case ARGX_TYPE_DOUBLE:
+        case ARGX_TYPE_FLOAT:
+        case ARGX_TYPE_COLOR:
+        case ARGX_TYPE_CUSTOM:
+        case ARGX_TYPE_URI:
+        case ARGX_TYPE_STRING: return true;
+        default: return false;
+    }
+}
+
+/* [true,false,...], 0b1011, 0xff00 or a single bool, all of it gets appended at once */
+static int static_arg_parse_argx_bits(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
+    Argx_Bits bits = {0};
+    int result = 0;
+    so = so_trim(so);
+    char base = so_len(so) > 2 && so_at0(so) == '0' ? so_at(so, 1) : 0;
+    if(so_at0(so) == '[' && so_atE(so) == ']') {
+        so = so_sub(so, 1, so_len(so) - 1);
+        for(So sp = SO; !result && so_splice(so, &sp, ','); ) {
+            bool v;
+            result = so_as_yes_or_no(so_trim(sp), &v);
+            if(!result) argx_bits_push(&bits, v);
+        }
+    } else if(base == 'b' || base == 'x') {
+        for(size_t i = 2; !result && i < so_len(so); ++i) {
+            char c = so_at(so, i);
+            if(base == 'b' && (c == '0' || c == '1')) {
+                argx_bits_push(&bits, c == '1');
+            } else if(base == 'x' && isxdigit((unsigned char)c)) {
+                int d = isdigit((unsigned char)c) ? c - '0' : tolower((unsigned char)c) - 'a' + 10;
+                for(int j = 3; j >= 0; --j) {
+                    argx_bits_push(&bits, (d >> j) & 1);
+                }
+            } else {
+                result = -1;
+            }
+        }
+    } else {
+        bool v;
+        result = so_as_yes_or_no(so, &v);
+        if(!result) argx_bits_push(&bits, v);
+    }
+    if(!result) arg_parse_setval_argx(argx, &(Argx_Value_Union){ .bits = &bits }, stream->source, false);
+    argx_bits_free(&bits);
+    return result;
+}
+
+/* 0-63,128,200-255 (or as an array); all of it gets merged at once */
+static int static_arg_parse_argx_range(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
+    Argx_Range *ranges = 0;
+    int result = 0;
+    so = so_trim(so);
+    if(so_at0(so) == '[' && so_atE(so) == ']') {
+        so = so_sub(so, 1, so_len(so) - 1);
+    }
+    for(So sp = SO; !result && so_splice(so, &sp, ','); ) {
+        sp = so_trim(sp);
+        Argx_Range r = {0};
+        /* the lower bound might be negative */
+        size_t i = so_len(sp) ? so_find_ch(so_i0(sp, 1), '-') + 1 : 0;
+        if(i < so_len(sp)) {
+            result = so_as_ssize(so_trim(so_iE(sp, i)), &r.lo, 0);
+            if(!result) result = so_as_ssize(so_trim(so_i0(sp, i + 1)), &r.hi, 0);
+            if(!result && r.lo > r.hi) result = -1;
+        } else {
+            result = so_as_ssize(sp, &r.lo, 0);
+            r.hi = r.lo;
+        }
+        if(!result) array_push(ranges, r);
+    }
+    if(!result) arg_parse_setval_argx(argx, &(Argx_Value_Union){ .vr = &ranges }, stream->source, false);
+    array_free(ranges);
+    return result;
+}
+
+/* key=value (or as an array); reports its own errors */
+static int static_arg_parse_argx_map(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
+    /* argv got split on the first '=' (as in --opt=value), take all of --label a=1 */
+    if(stream->i < arg_stream_len(stream) && stream->carg.str == so.str) {
+        So carg = arg_stream_at(stream, stream->i);
+        if(carg.str == so.str && so_len(carg) > so_len(so)) {
+            so = carg;
+            stream->carg = carg;
+        }
+    }
+    so = so_trim(so);
+    if(so_at0(so) == '[' && so_atE(so) == ']') {
+        so = so_sub(so, 1, so_len(so) - 1);
+    }
+    for(So sp = SO; so_splice(so, &sp, ','); ) {
+        sp = so_trim(sp);
+        size_t i = so_find_ch(sp, '=');
+        So key = so_trim(so_iE(sp, i));
+        if(i >= so_len(sp) || !so_len(key)) {
+            arg_parse_error(arg, stream, ARG_PARSE_ERROR_INVALID_CONVERSION, argx);
+            return -1;
+        }
+        if(argx->attr.is_unique_keys && argx->val.map) {
+            /* once per source, a later one (e.g. argv over a config) overrides it; keys of the default don't count */
+            Argx_So_Map_Item *item = argx_so_map_item(*argx->val.map, key);
+            if(item && item->source.id == stream->source.id && !so_cmp(item->source.path, stream->source.path)) {
+                arg_parse_error(arg, stream, ARG_PARSE_ERROR_DUPLICATE_KEY, argx);
+                return -1;
+            }
+        }
+        Argx_So_Map_Item kv = { .key = key, .val = so_trim(so_i0(sp, i + 1)) };
+        arg_parse_setval_argx(argx, &(Argx_Value_Union){ .kv = &kv }, stream->source, true);
+    }
+    return 0;
+}
+
+static int static_arg_parse_argx_convert(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
     int result = -1;
-    arg_parse_set_help_any(arg, argx); /* set help BEFORE doing any further parsing */
-    if(stream->is_config && !argx_is_configurable(argx)) {
-        result = -1;
-        arg_parse_error(arg, stream, ARG_PARSE_ERROR_UNCONFIGURABLE, argx);
+    if(argx->attr.is_map) {
+        result = static_arg_parse_argx_map(arg, stream, argx, so);
+    } else if(argx->attr.is_bitset || argx->attr.is_range) {
+        if(argx->attr.is_range) result = static_arg_parse_argx_range(arg, stream, argx, so);
+        else result = static_arg_parse_argx_bits(arg, stream, argx, so);
+        if(result) {
+            arg_parse_error(arg, stream, ARG_PARSE_ERROR_INVALID_CONVERSION, argx);
+        }
     } else if(argx->attr.is_array) {
         if(argx->id < ARGX_TYPE__COUNT) {
             Arg_Parse_Argx_Callback cb = static_parse_argx_vector_vals_cbs[argx->id];
@@ -708,10 +983,7 @@ int arg_parse_argx(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
             }
         }
     } else {
-        if(argx->sources) {
-            /* TODO: ability to detect duplicate setting of values... for now just clear sources so they don't pile up */
-            array_clear_ext(argx->sources, so_free);
-        }
+        /* TODO: ability to detect duplicate setting of values... for now the most recent source replaces argx->source */
         if(argx->id < ARGX_TYPE__COUNT) {
             Arg_Parse_Argx_Callback cb = static_parse_argx_single_cbs[argx->id];
             ASSERT_ARG(cb);
@@ -721,21 +993,156 @@ int arg_parse_argx(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
             }
         }
     }
-    if(!result && argx->callback.func) {
-        bool skip = false;
-        if(arg->builtin.compgen && argx->attr.callback_skip_compgen) skip = true;
-        if(!skip) {
-            if(argx->callback.priority == ARGX_PRIORITY_IMMEDIATELY) {
-                result = argx->callback.func(argx, argx->callback.user, so);
-            } else if(argx->callback.priority == ARGX_PRIORITY_WHEN_ALL_VALID) {
-                Argx_Callback_Queue q = { .argx = argx, .so = so };
+    return result;
+}
+
+static bool static_arg_parse_skip_callback(struct Arg *arg, Argx *argx) {
+    if(arg->builtin.compgen && argx->attr.callback_skip_compgen) return true;
+    if(arg->builtin.batch && !argx->attr.callback_batch) return true;
+    return false;
+}
+
+int arg_parse_argx(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so) {
+    ASSERT_ARG(arg);
+    ASSERT_ARG(stream);
+    ASSERT_ARG(argx);
+    //printff("PARSE: %.*s <== '%.*s'",SO_F(argx->opt), SO_F(so));
+    int result = -1;
+    bool deferred = false;
+    arg_parse_set_help_any(arg, argx); /* set help BEFORE doing any further parsing */
+    if(stream->is_config && !argx_is_configurable(argx)) {
+        result = -1;
+        arg_parse_error(arg, stream, ARG_PARSE_ERROR_UNCONFIGURABLE, argx);
+    } else if(arg_parse_argx_is_deferred(arg, argx)) {
+        /* the raw value outlives the parse: argv, environment or sources_content */
+        arg_parse_argx_defer(arg, stream, argx, so, SO);
+        deferred = true;
+        result = 0;
+    } else {
+        result = static_arg_parse_argx_convert(arg, stream, argx, so);
+    }
+    if(!result && argx->callback.func && !static_arg_parse_skip_callback(arg, argx)) {
+        if(argx->callback.priority == ARGX_PRIORITY_IMMEDIATELY) {
+            result = argx->callback.func(argx, argx->callback.user, so);
+        } else if(!deferred) {
+            Argx_Callback_Queue q = { .argx = argx, .so = so };
+            array_push(arg->queue, q);
+        }
+    }
+    return result;
+}
+
+/* remember an assignment instead of converting it; a scalar only keeps the most recent one.
+ * with a file, it only gets read once it turns out to be the assignment that counts */
+void arg_parse_argx_defer(struct Arg *arg, Arg_Stream *stream, Argx *argx, So so, So file) {
+    ASSERT_ARG(arg);
+    ASSERT_ARG(stream);
+    ASSERT_ARG(argx);
+    Argx_Pending pending = {
+        .so = so,
+        .file = so_clone(file),
+        .source = stream->source,
+        .is_config = stream->is_config,
+    };
+    if(pending.source.id == ARG_STREAM_SOURCE_CONFIG) {
+        pending.source.path = so_clone(pending.source.path);
+    }
+    if(!argx->attr.is_array) array_free_ext(argx->pending, argx_pending_free);
+    array_push(argx->pending, pending);
+}
+
+/* same as the config parser does with file("..."), every line is a value */
+static int static_arg_parse_argx_convert_file(struct Arg *arg, Arg_Stream *stream, Argx *argx, So file) {
+    So content = SO;
+    if(so_file_read(file, &content)) {
+        Argx pseudo = { .opt = file };
+        arg_parse_error(arg, stream, ARG_PARSE_ERROR_INVALID_FILE, &pseudo);
+        return -1;
+    }
+    vso_push(&arg->builtin.sources_content, content);
+    int result = 0;
+    for(So line = SO; so_splice(content, &line, '\n'); ) {
+        if(so_is_zero(line)) continue;
+        line = so_trim(line);
+        if(!so_len(line)) continue;
+        stream->carg = line;
+        if(static_arg_parse_argx_convert(arg, stream, argx, line)) result = -1;
+    }
+    return result;
+}
+
+static int static_argx_resolve(struct Arg *arg, Argx *argx, bool queue) {
+    /* detach first, converting checks argx_is_set */
+    Argx_Pending *pending = argx->pending;
+    argx->pending = 0;
+    int result = 0;
+    Argx_Pending *itE = array_itE(pending);
+    for(Argx_Pending *it = pending; !result && it < itE; ++it) {
+        Arg_Stream stream = { .source = it->source, .is_config = it->is_config, .carg = it->so };
+        if(so_len(it->file)) {
+            result = static_arg_parse_argx_convert_file(arg, &stream, argx, it->file);
+        } else {
+            result = static_arg_parse_argx_convert(arg, &stream, argx, it->so);
+        }
+        if(!result && argx->callback.func && !static_arg_parse_skip_callback(arg, argx)) {
+            if(argx->callback.priority == ARGX_PRIORITY_IMMEDIATELY) continue;
+            if(queue) {
+                Argx_Callback_Queue q = { .argx = argx, .so = stream.carg };
                 array_push(arg->queue, q);
+            } else {
+                result = argx->callback.func(argx, argx->callback.user, stream.carg);
             }
         }
     }
+    array_free_ext(pending, argx_pending_free);
+    return result;
+}
+
+int argx_resolve(struct Argx *argx) {
+    ASSERT_ARG(argx);
+    if(!argx->pending) return 0;
+    ASSERT_ARG(argx->group_p);
+    Arg *arg = argx->group_p->arg;
+    ASSERT_ARG(arg);
+    return static_argx_resolve(arg, argx, false);
+}
+
+/* all_lazy: also the ones left for argx_resolve, else only the layered ones */
+static int static_arg_resolve_group(struct Arg *arg, Argx_Group *group, bool all_lazy) {
+    int result = 0;
+    for(Argx *it = group->list; it; it = it->next) {
+        if(it->pending) {
+            if(all_lazy) {
+                result |= static_argx_resolve(arg, it, false);
+            } else if(!static_arg_parse_is_lazy(arg, it)) {
+                result |= static_argx_resolve(arg, it, true);
+            }
+        }
+        if(it->group_s) result |= static_arg_resolve_group(arg, it->group_s, all_lazy);
+    }
+    return result;
+}
+
+static int static_arg_resolve(struct Arg *arg, bool all_lazy) {
+    int result = static_arg_resolve_group(arg, &arg->pos, all_lazy);
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        result |= static_arg_resolve_group(arg, group, all_lazy);
+    }
+    result |= static_arg_resolve_group(arg, &arg->env, all_lazy);
     return result;
 }
 
+int arg_resolve(struct Arg *arg) {
+    ASSERT_ARG(arg);
+    return static_arg_resolve(arg, true);
+}
+
+/* the next positional to parse, following the previous one */
+static Argx *static_arg_parse_pos_next(struct Arg *arg) {
+    if(!arg->i_pos) arg->pos_next = arg->pos.list;
+    return arg->pos_next;
+}
+
 int arg_parse_positional(struct Arg *arg, Arg_Stream *stream, Argx *argx) {
     ASSERT_ARG(arg);
     ASSERT_ARG(stream);
@@ -787,25 +1194,33 @@ Argx *arg_parse_hierarchy(struct Arg *arg, Arg_Stream *stream, So hierarchy, Arg
     So root = so_trim(so_split_ch(hierarchy, '.', &hierarchy));
 
     /* verify that the root group exists */
+    Argx_Group *scope = 0; /* zero to look up within all long options */
     bool exist = false;
-    Argx_Groups groupE = array_itE(arg->opts);
-    for(Argx_Groups group = arg->opts; group < groupE; ++group) {
-        if(so_cmp((*group)->name, root)) continue;
-        if(root_group) *root_group = *group;
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        if(so_cmp(group->name, root)) continue;
+        if(root_group) *root_group = group;
+        if(group->is_subcommand) scope = group;
         exist = true;
         break;
     }
-    T_Argx *table = &arg->t_opt;
+    Argx *subcommand = exist ? 0 : arg_get_subcommand(arg, root);
+    if(subcommand) {
+        Argx_Group *group = argx_group_subcommand(subcommand);
+        if(root_group) *root_group = group;
+        scope = group;
+        exist = true;
+    }
+    bool have_scope = true;
     if(!exist && stream->is_help_lookup) {
         ASSERT_ARG(root_group);
         if(!so_cmp(arg->env.name, root)) {
             *root_group = &arg->env;
-            table = &arg->t_env;
+            scope = &arg->env;
             exist = true;
         }
         if(!so_cmp(arg->pos.name, root)) {
             *root_group = &arg->pos;
-            table = &arg->t_pos;
+            scope = &arg->pos;
             exist = true;
         }
     }
@@ -817,14 +1232,15 @@ Argx *arg_parse_hierarchy(struct Arg *arg, Arg_Stream *stream, So hierarchy, Arg
 
     /* now search for sub option */
     for(So opt = SO; so_splice(hierarchy, &opt, '.'); ) {
-        if(!table) {
+        if(!have_scope) {
             Argx pseudo = { .opt = hierarchy };
             arg_parse_error(arg, stream, ARG_PARSE_ERROR_HIERARCHY_TABLE_CONFIG, &pseudo);
             return 0;
         }
-        result = t_argx_get(table, opt);
+        result = scope ? argx_group_get(scope, opt) : arg_get_opt(arg, opt);
         if(!result && stream->is_help_lookup && so_len(opt) == 1) {
-            result = arg_parse_get_shortopt(arg, so_at0(opt));
+            bool is_subcommand = scope && scope->is_subcommand;
+            result = is_subcommand ? argx_group_get_short(scope, so_at0(opt)) : arg_parse_get_shortopt(arg, so_at0(opt));
         }
         if(!result) {
             /* lastly, bail out */
@@ -832,8 +1248,9 @@ Argx *arg_parse_hierarchy(struct Arg *arg, Arg_Stream *stream, So hierarchy, Arg
             arg_parse_error(arg, stream, ARG_PARSE_ERROR_HIERARCHY_TABLE_CONFIG, &pseudo);
             return 0;
         }
-        table = result->group_s ? result->group_s->table : 0;
-        if(table && root_group) *root_group = result->group_s;
+        scope = argx_group_sub(result);
+        have_scope = (bool)scope;
+        if(scope && root_group) *root_group = scope;
     }
 
     return result;
@@ -850,7 +1267,7 @@ int arg_parse_stream(struct Arg *arg, Arg_Stream *stream) {
         /* determine kind of situation... */
         if(get_env_help) goto error_but_maybe_get_env_help;
         Arg_Stream_List situation = ARG_STREAM_DONE;
-        if(stream->i < array_len(stream->vso)) situation = ARG_STREAM_REST;
+        if(stream->i < arg_stream_len(stream)) situation = ARG_STREAM_REST;
         if(!stream->skip_flag_check) {
             if(!so_cmp0(carg, so("--")) && carg.len > 2) situation = ARG_STREAM_LONGOPT;
             else if(!so_cmp0(carg, so("-"))) situation = ARG_STREAM_SHORTOPT;
@@ -861,9 +1278,9 @@ int arg_parse_stream(struct Arg *arg, Arg_Stream *stream) {
             case ARG_STREAM_DONE: break;
             case ARG_STREAM_REST: {
                 /* we want to set the rest? check if there are remaining positional arguments to be set */
-                //printff("I_POS %u / %zu", arg->i_pos, array_len(arg->pos.list));
-                if(arg->i_pos < array_len(arg->pos.list) && !stream->rest) {
-                    Argx *pos = array_at(arg->pos.list, arg->i_pos);
+                //printff("I_POS %u / %zu", arg->i_pos, arg->pos.list_len);
+                if(arg->i_pos < arg->pos.list_len && !stream->rest) {
+                    Argx *pos = static_arg_parse_pos_next(arg);
                     //printff("GOT POSITIONAL ARGX: %.*s", SO_F(pos->opt));
                     if(arg_parse_positional(arg, stream, pos)) {
                         arg_parse_error(arg, stream, ARG_PARSE_ERROR_UNHANDLED_POSITIONAL, 0);
@@ -871,6 +1288,7 @@ int arg_parse_stream(struct Arg *arg, Arg_Stream *stream) {
                         goto error_but_maybe_get_env_help;
                     }
                     ++arg->i_pos;
+                    arg->pos_next = pos->next;
                     //printff("POSITIONAL ARGX PARSED OK! -> i_pos %u", arg->i_pos);
                 } else {
                     //printff(" SET REST!");
@@ -888,7 +1306,7 @@ int arg_parse_stream(struct Arg *arg, Arg_Stream *stream) {
             } break;
             case ARG_STREAM_LONGOPT: {
                 So opt = so_i0(carg, 2);
-                Argx *argx = t_argx_get(&arg->t_opt, opt);
+                Argx *argx = arg_get_opt(arg, opt);
                 if(!argx) {
                     Argx pseudo = { .opt = opt };
                     arg_parse_error(arg, stream, ARG_PARSE_ERROR_INVALID_OPTION_ROOT, &pseudo);
@@ -956,7 +1374,7 @@ int arg_parse_setref_argx_flag(Argx *argx, bool clear) {
     Argx_Value_Union flag = argx->ref;
     int status = 0;
     if(clear) {
-        if(!argx->sources) {
+        if(!argx_is_explicit(argx)) {
             flag.b = &(bool){ false };
             status |= arg_parse_setval_argx(argx, &flag, ARGX_SOURCE_REFVAL, false);
         }
@@ -967,11 +1385,54 @@ int arg_parse_setref_argx_flag(Argx *argx, bool clear) {
 }
 
 int arg_parse_setref_argx(Argx *argx) {
-    if(argx->sources) return 0; /* do not setref if it was already parsed somewhere else */
+    if(argx_is_set(argx)) return 0; /* do not setref if it was already parsed somewhere else */
+    if(argx->id == ARGX_TYPE_GROUP) {
+        /* of all groups only an enum and a flag mask have a value */
+        if(!argx->group_s) return 0;
+        if(argx->group_s->is_bitmask) {
+            if(!argx->val.mask || !argx->ref.mask) return 0;
+            *argx->val.mask = *argx->ref.mask;
+            arg_parse_add_source(argx, ARGX_SOURCE_REFVAL);
+            return 0;
+        }
+        if(argx->group_s->id != ARGX_GROUP_ENUM) return 0;
+        if(!argx->val.i || !argx->ref.i) return 0;
+        *argx->val.i = *argx->ref.i;
+        arg_parse_add_source(argx, ARGX_SOURCE_REFVAL);
+        return 0;
+    }
     int status = arg_parse_setval_argx(argx, &argx->ref, ARGX_SOURCE_REFVAL, false);
     return status;
 }
 
+/* write the reference as soon as it is known, so arg_parse doesn't have to visit every argx */
+void arg_parse_setref_bind(Argx *argx) {
+    ASSERT_ARG(argx);
+    ASSERT_ARG(argx->group_p);
+    ASSERT_ARG(argx->group_p->arg);
+    if(!argx->ref.any) return;
+    /* positional arguments never got their reference */
+    if(argx_is_subgroup_of_root(argx, &argx->group_p->arg->pos)) return;
+    arg_parse_setref_argx(argx);
+}
+
+void arg_parse_dirty_flags_clear(struct Arg *arg) {
+    for(Argx_Group *group = arg->dirty_flags, *next; group; group = next) {
+        next = group->dirty;
+        group->dirty = 0;
+    }
+    arg->dirty_flags = 0;
+}
+
+/* a flag got set, the others of its group have to be cleared after parsing */
+static void static_arg_parse_dirty_flags(Argx *argx) {
+    Argx_Group *group = argx->group_p;
+    if(!group || group->id != ARGX_GROUP_FLAGS) return;
+    if(group->dirty || group->arg->dirty_flags == group) return;
+    group->dirty = group->arg->dirty_flags;
+    group->arg->dirty_flags = group;
+}
+
 #if 0
 int arg_parse_setval_argx_callback_refval(Argx *argx, Argx_Value_Union *ref, Arg_Stream_Source src, bool argx_is_array_but_value_is_not) {
     bool single = argx_is_array_but_value_is_not;
@@ -1005,12 +1466,50 @@ int arg_parse_setval_argx_callback_refval(Argx *argx, Argx_Value_Union *ref, Arg
 }
 #endif
 
+/* a value left at its default array shares it, until anything else sets the argx */
+static void static_arg_parse_drop_default(Argx *argx, Arg_Stream_Source src) {
+    if(src.id == ARG_STREAM_SOURCE_REFVAL) return;
+    if(!argx->val.any || !argx->ref.any) return;
+    if(argx_is_explicit(argx)) return;
+    void **val = argx->val.any;
+    if(*val != *(void **)argx->ref.any) return;
+    *val = 0;
+    if(argx->attr.is_bitset) argx->val.bits->len = 0;
+    array_free_ext(argx->sources, arg_stream_source_free);
+}
+
 int arg_parse_setval_argx(Argx *argx, Argx_Value_Union *ref, Arg_Stream_Source src, bool argx_is_array_but_value_is_not) {
     bool single = argx_is_array_but_value_is_not;
     int status = 0;
     //printff("setval for: %.*s",SO_F(argx->opt));
     if(ref && ref->any) {
-        if(argx->attr.is_array) {
+        bool share = argx->attr.is_array && !single && ref == &argx->ref && argx->val.any && !*(void **)argx->val.any;
+        if(share) {
+            /* every array member of the union points to the array, one record for all of the default */
+            if(argx->attr.is_bitset) *argx->val.bits = *ref->bits;
+            else *(void **)argx->val.any = *(void **)ref->any;
+            arg_parse_setref_sources_mono(argx, src, (bool)*(void **)ref->any);
+        } else if(argx->attr.is_bitset || argx->attr.is_range || argx->attr.is_set || argx->attr.is_map) {
+            static_arg_parse_drop_default(argx, src);
+            if(argx->attr.is_map) {
+                /* each key keeps its own source */
+                if(argx->val.map) {
+                    if(single) argx_so_map_put(argx->val.map, ref->kv->key, ref->kv->val, src);
+                    else argx_so_map_extend(argx->val.map, *ref->map);
+                }
+            } else if(argx->attr.is_set) {
+                if(argx->val.set) {
+                    if(single) argx_so_set_add(argx->val.set, *ref->so);
+                    else argx_so_set_extend(argx->val.set, *ref->set);
+                }
+            } else if(argx->attr.is_range) {
+                if(argx->val.vr) argx_range_merge(argx->val.vr, *ref->vr);
+            } else if(argx->val.bits) {
+                argx_bits_extend(argx->val.bits, ref->bits);
+            }
+            static_arg_parse_add_source_packed(argx, src);
+        } else if(argx->attr.is_array) {
+            static_arg_parse_drop_default(argx, src);
             switch(argx->id) {
                 default: ABORT(ERR_UNREACHABLE("unhandled id %u"), argx->id);
                 case ARGX_TYPE_BOOL: {
@@ -1046,13 +1545,28 @@ int arg_parse_setval_argx(Argx *argx, Argx_Value_Union *ref, Arg_Stream_Source s
                         else array_push(*argx->val.vz, *ref->z);
                     }
                 } break;
+                case ARGX_TYPE_DOUBLE: {
+                    if(argx->val.vd) {
+                        if(!single) array_extend(*argx->val.vd, *ref->vd);
+                        else array_push(*argx->val.vd, *ref->d);
+                    }
+                } break;
+                case ARGX_TYPE_FLOAT: {
+                    if(argx->val.vf) {
+                        if(!single) array_extend(*argx->val.vf, *ref->vf);
+                        else array_push(*argx->val.vf, *ref->f);
+                    }
+                } break;
                 case ARGX_TYPE_NONE: break;
                 //case ARGX_TYPE_REST: ABORT(ERR_UNREACHABLE("case will never provide default values"));
                 case ARGX_TYPE_GROUP: ABORT(ERR_UNREACHABLE("case is handled separately"));
                 case ARGX_TYPE_ENUM: ABORT(ERR_UNREACHABLE("case is handled separately"));
                 case ARGX_TYPE_FLAG: ABORT(ERR_UNREACHABLE("case is handled separately"));
             }
-            if(!single) arg_parse_setref_sources_mono(argx, src, array_len(*ref->vb));
+            if(argx->id == ARGX_TYPE_DOUBLE || argx->id == ARGX_TYPE_FLOAT) {
+                /* converted in bulk, one record per run of the same source */
+                if(single || array_len(*ref->vd)) static_arg_parse_add_source_packed(argx, src);
+            } else if(!single) arg_parse_setref_sources_mono(argx, src, array_len(*ref->vb));
             else arg_parse_setref_sources_mono(argx, src, 1);
         } else {
             //printff(" v %p = r %p id %u [%.*s]",argx->val,argx->ref,argx->id,SO_F(argx->opt));
@@ -1060,7 +1574,15 @@ int arg_parse_setval_argx(Argx *argx, Argx_Value_Union *ref, Arg_Stream_Source s
             switch(argx->id) {
                 default: ABORT(ERR_UNREACHABLE("unhandled id %u"), argx->id);
                 case ARGX_TYPE_FLAG: {
+                    if(argx->group_p->is_bitmask) {
+                        /* e.g. a switch or flag.name = true */
+                        uint64_t bit = (uint64_t)1 << argx->attr.val_enum;
+                        bool on = ref->b && *ref->b;
+                        static_arg_parse_setval_mask(argx->group_p->parent, on ? bit : 0, on ? 0 : bit, false, src);
+                        break;
+                    }
                     if(argx->val.b) *argx->val.b = *ref->b;
+                    if(src.id != ARG_STREAM_SOURCE_REFVAL) static_arg_parse_dirty_flags(argx);
                 } break;
                 case ARGX_TYPE_COLOR: {
                     if(argx->val.c) *argx->val.c = *ref->c;
@@ -1078,6 +1600,16 @@ int arg_parse_setval_argx(Argx *argx, Argx_Value_Union *ref, Arg_Stream_Source s
                 case ARGX_TYPE_SIZE: {
                     if(argx->val.z) *argx->val.z = *ref->z;
                 } break;
+                case ARGX_TYPE_DOUBLE: {
+                    if(argx->val.d) *argx->val.d = *ref->d;
+                } break;
+                case ARGX_TYPE_FLOAT: {
+                    if(argx->val.f) *argx->val.f = *ref->f;
+                } break;
+                case ARGX_TYPE_CUSTOM: {
+                    /* the converted value or the default */
+                    if(argx->val.any && argx->val.any != ref->any) memcpy(argx->val.any, ref->any, argx->custom.type->size);
+                } break;
                 case ARGX_TYPE_NONE: break;
                 case ARGX_TYPE_REST: ABORT(ERR_UNREACHABLE("case will never provide default values"));
                 case ARGX_TYPE_GROUP: ABORT(ERR_UNREACHABLE("case is handled separately"));
@@ -1102,25 +1634,25 @@ int arg_parse_setval_argx(Argx *argx, Argx_Value_Union *ref, Arg_Stream_Source s
 int arg_parse_setref_group(Argx_Group *group) {
     if(!group) return 0;
     int status = 0;
-    for(Argx **it = group->list; it < array_itE(group->list); ++it) {
-        //printff("setref for: %.*s",SO_F((*it)->opt));
-        ASSERT_ARG(it);
-        Argx *argx = *it;
-        ASSERT_ARG(argx);
+    for(Argx *argx = group->list; argx; argx = argx->next) {
+        //printff("setref for: %.*s",SO_F(argx->opt));
         if(argx->id == ARGX_TYPE_GROUP) {
             if(!argx->group_s) continue;
             switch(argx->group_s->id) {
                 case ARGX_GROUP_FLAGS: {
+                    if(argx->group_s->is_bitmask) {
+                        status |= arg_parse_setref_argx(argx);
+                        break;
+                    }
                     bool should_clear = false;
                     if(argx->group_p) {
-                        Argx **itE = array_itE(argx->group_s->list);
-                        for(Argx **it = argx->group_s->list; it < itE; ++it) {
-                            if(!(*it)->sources) continue;
+                        for(Argx *it = argx->group_s->list; it; it = it->next) {
+                            if(!argx_is_explicit(it)) continue;
                             should_clear = true;
                             break;
                         }
-                        for(Argx **it = argx->group_s->list; it < itE; ++it) {
-                            status |= arg_parse_setref_argx_flag(*it, should_clear);
+                        for(Argx *it = argx->group_s->list; it; it = it->next) {
+                            status |= arg_parse_setref_argx_flag(it, should_clear);
                         }
                     }
                 } break;
@@ -1130,8 +1662,7 @@ int arg_parse_setref_group(Argx_Group *group) {
                     status |= arg_parse_setref_group(argx->group_s); 
                 } break;
                 case ARGX_GROUP_ENUM: {
-                    if(argx->sources) continue;
-                    argx->val = argx->ref; 
+                    status |= arg_parse_setref_argx(argx);
                 } break;
             }
         } else {
@@ -1144,10 +1675,21 @@ int arg_parse_setref_group(Argx_Group *group) {
 int arg_parse_setref(struct Arg *arg) {
     /* apply values from references */
     int status = 0;
-    for(Argx_Group **group = arg->opts; group < array_itE(arg->opts); ++group) {
-        status |= arg_parse_setref_group(*group);
+    if(arg->setref_all) {
+        for(Argx_Group *group = arg->opts; group; group = group->next) {
+            status |= arg_parse_setref_group(group);
+        }
+        status |= arg_parse_setref_group(&arg->env);
+        arg->setref_all = false;
+    } else {
+        /* references got written when they were bound, only flags of a group where one got set remain */
+        for(Argx_Group *group = arg->dirty_flags; group; group = group->dirty) {
+            for(Argx *flag = group->list; flag; flag = flag->next) {
+                status |= arg_parse_setref_argx_flag(flag, true);
+            }
+        }
     }
-    status |= arg_parse_setref_group(&arg->env);
+    arg_parse_dirty_flags_clear(arg);
     return status;
 }
 
@@ -1155,23 +1697,176 @@ int arg_parse_setref(struct Arg *arg) {
 
 /* parsing entry points {{{ */
 
+extern char **environ;
+
+/* does the variable start with the option, e.g. SEQ_OPTION_B with option? */
+static size_t static_arg_parse_env_prefixed_match(So name, size_t i, So opt) {
+    for(size_t j = 0; j < so_len(opt); ++j, ++i) {
+        if(i >= so_len(name)) return 0;
+        char c = so_at(opt, j);
+        char e = so_at(name, i);
+        if(c == '-' || c == '_') {
+            if(e != '_') return 0;
+        } else if(e != toupper((unsigned char)c)) {
+            return 0;
+        }
+    }
+    return i;
+}
+
+/* the option a variable maps to: underscores either separate levels of the hierarchy or stand for a '-' or '_' of an option */
+static Argx *static_arg_parse_env_prefixed_find(Argx_Group *scope, So name, size_t i, So *tmp) {
+    for(size_t k = i; k <= so_len(name); ++k) {
+        if(k < so_len(name) && so_at(name, k) != '_') continue;
+        if(k == i) return 0;
+        for(int spelling = 0; spelling < 2; ++spelling) {
+            so_clear(tmp);
+            bool has_underscore = false;
+            for(size_t j = i; j < k; ++j) {
+                char c = so_at(name, j);
+                has_underscore |= (c == '_');
+                so_push(tmp, c == '_' ? (spelling ? '_' : '-') : tolower((unsigned char)c));
+            }
+            if(spelling && !has_underscore) break;
+            /* the root groups share one table */
+            Argx *argx = argx_group_get(scope, *tmp);
+            if(!argx || argx->group_p != scope) continue;
+            if(k == so_len(name)) {
+                if(argx_is_configurable(argx)) return argx;
+                continue;
+            }
+            Argx_Group *sub = argx_group_sub(argx);
+            if(!sub) continue;
+            Argx *result = static_arg_parse_env_prefixed_find(sub, name, k + 1, tmp);
+            if(result) return result;
+        }
+    }
+    return 0;
+}
+
+static Argx *static_arg_parse_env_prefixed(struct Arg *arg, So name, So *tmp) {
+    size_t i = so_len(arg->config.env_prefix);
+    if(so_len(name) <= i + 1 || so_cmp(so_iE(name, i), arg->config.env_prefix) || so_at(name, i) != '_') return 0;
+    ++i;
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        size_t k = static_arg_parse_env_prefixed_match(name, i, group->name);
+        if(!k || k >= so_len(name) || so_at(name, k) != '_') continue;
+        Argx *argx = static_arg_parse_env_prefixed_find(group, name, k + 1, tmp);
+        if(argx) return argx;
+    }
+    return 0;
+}
+
+static int static_arg_parse_env_cmp_argx(const void *a, const void *b) {
+    const Arg_Env_Value *x = a, *y = b;
+    if(x->argx != y->argx) return x->argx < y->argx ? -1 : 1;
+    return x->i < y->i ? -1 : (x->i > y->i);
+}
+
+static int static_arg_parse_env_cmp_argx_only(const void *a, const void *b) {
+    const Arg_Env_Value *x = a, *y = b;
+    return x->argx < y->argx ? -1 : (x->argx > y->argx);
+}
+
+static int static_arg_parse_env_cmp_i(const void *a, const void *b) {
+    const Arg_Env_Value *x = a, *y = b;
+    return x->i < y->i ? -1 : (x->i > y->i);
+}
+
+/* sorted by argx, only the first one of each is kept, as getenv would take it */
+static void static_arg_parse_env_first(Arg_Env_Value **values) {
+    size_t n = array_len(*values);
+    if(n < 2) return;
+    Arg_Env_Value *sorted = *values;
+    *values = 0;
+    qsort(sorted, n, sizeof(*sorted), static_arg_parse_env_cmp_argx);
+    for(size_t j = 0; j < n; ++j) {
+        if(j && sorted[j].argx == sorted[j - 1].argx) continue;
+        array_push(*values, sorted[j]);
+    }
+    array_free(sorted);
+}
+
+/* one pass over environ with a lookup into the table, instead of a getenv per argx */
+static void static_arg_parse_environment_gather(struct Arg *arg) {
+    So tmp = SO;
+    bool prefixed = so_len(arg->config.env_prefix);
+    array_free(arg->env_found);
+    array_free(arg->env_prefixed);
+    size_t i = 0;
+    for(char **it = environ; it && *it; ++it, ++i) {
+        So val = SO;
+        So name = so_split_ch(so_l(*it), '=', &val);
+        if(!so_len(val)) continue;
+        Argx *argx = arg->env.table ? argx_group_get(&arg->env, name) : 0;
+        Arg_Env_Value env = { .argx = argx, .val = val, .i = i };
+        if(argx) {
+            array_push(arg->env_found, env);
+        } else if(prefixed && (env.argx = static_arg_parse_env_prefixed(arg, name, &tmp))) {
+            array_push(arg->env_prefixed, env);
+        }
+    }
+    so_free(&tmp);
+    static_arg_parse_env_first(&arg->env_found);
+    static_arg_parse_env_first(&arg->env_prefixed);
+    /* the prefixed ones get parsed in the order of environ */
+    if(array_len(arg->env_prefixed) > 1) qsort(arg->env_prefixed, array_len(arg->env_prefixed), sizeof(*arg->env_prefixed), static_arg_parse_env_cmp_i);
+}
+
+static So static_arg_parse_env_found(struct Arg *arg, Argx *argx) {
+    if(!arg->env_found) return SO;
+    Arg_Env_Value key = { .argx = argx };
+    Arg_Env_Value *found = bsearch(&key, arg->env_found, array_len(arg->env_found), sizeof(key), static_arg_parse_env_cmp_argx_only);
+    return found ? found->val : SO;
+}
+
+static int static_arg_parse_environment_value(struct Arg *arg, Arg_Stream *stream, Argx *argx, So env) {
+    So carg = SO;
+    arg_stream_clear(stream);
+    /* the value is taken as-is, e.g. COMPGEN_WORD=--opt=val */
+    stream->skip_flag_check = true;
+    vso_push(&stream->vso, env);
+    arg_stream_get_next(stream, &carg, &arg->builtin.compgen_flags);
+    return arg_parse_argx(arg, stream, argx, carg);
+}
+
 int arg_parse_environment(struct Arg *arg) {
     /* gather environment variables */
     int status = 0;
-    Argx **itE = array_itE(arg->env.list);
-    So env = SO, carg = SO;
+    So env = SO;
     Arg_Stream stream_env = {
         .source = ARGX_SOURCE_ENVVARS,
     };
-    for(Argx **it = arg->env.list; it < itE && !status; ++it) {
-        so_env_get(&env, (*it)->opt);
-        //printff("PARSE ENV: %.*s: [%.*s]", SO_F((*it)->opt), SO_F(env));
+    /* without a table, looking up every variable is no better than getenv */
+    bool gather = arg->env.table || so_len(arg->config.env_prefix);
+    if(gather) static_arg_parse_environment_gather(arg);
+    for(Argx *it = arg->env.list; it && !status; it = it->next) {
+        if(arg->env.table) {
+            /* same order as registered */
+            env = static_arg_parse_env_found(arg, it);
+        } else {
+            so_env_get(&env, it->opt);
+        }
+        //printff("PARSE ENV: %.*s: [%.*s]", SO_F(it->opt), SO_F(env));
         if(!so_len(env)) continue;
-        arg_stream_clear(&stream_env);
-        vso_push(&stream_env.vso, env);
-        arg_stream_get_next(&stream_env, &carg, &arg->builtin.compgen_flags);
-        status = arg_parse_argx(arg, &stream_env, *it, carg);
+        status = static_arg_parse_environment_value(arg, &stream_env, it, env);
     }
+    array_free(arg->env_found);
+    arg_stream_free(&stream_env);
+    return status;
+}
+
+/* variables mapped by arg_config_set_env_prefix, they override configs but not argv */
+int arg_parse_environment_prefixed(struct Arg *arg) {
+    int status = 0;
+    Arg_Stream stream_env = {
+        .source = ARGX_SOURCE_ENVVARS,
+    };
+    Arg_Env_Value *itE = array_itE(arg->env_prefixed);
+    for(Arg_Env_Value *it = arg->env_prefixed; it < itE && !status; ++it) {
+        status = static_arg_parse_environment_value(arg, &stream_env, it->argx, it->val);
+    }
+    array_free(arg->env_prefixed);
     arg_stream_free(&stream_env);
     return status;
 }
@@ -1192,10 +1887,14 @@ int arg_queue_post_parsing(Arg *arg) {
     for(Argx_Callback_Queue *it = arg->queue; it < itE; ++it) {
         ASSERT_ARG(it->argx);
         ASSERT_ARG(it->argx->callback.func);
+        if(it->argx->callback.priority == ARGX_PRIORITY_WHEN_ALL_VALID_PARALLEL) continue;
         result = it->argx->callback.func(it->argx, it->argx->callback.user, it->so);
         if(arg->builtin.quit_early) break;
         if(result) break;
     }
+    if(!result && !arg->builtin.quit_early) {
+        result = argx_callback_queue_parallel(arg);
+    }
     return result;
 }
 
@@ -1256,10 +1955,10 @@ int arg_parse_help(Arg *arg, bool do_not_recurse) {
             } else if(arg->builtin.config_print_selected) {
                 arg_config(arg);
             } else if(!do_not_recurse) {
-                if(arg->i_pos < array_len(arg->pos.list)) {
+                if(arg->i_pos < arg->pos.list_len) {
                     if(isatty(STDIN_FILENO)) {
                         //arg_parse_errmsg_missing_positionals(arg);
-                        Argx *last = array_at(arg->pos.list, arg->i_pos);
+                        Argx *last = static_arg_parse_pos_next(arg);
                         if(last->id != ARGX_TYPE_REST) {
                             arg_parse_error(arg, &arg->stream_in, ARG_PARSE_ERROR_MISSING_POSITIONAL, last);
                             arg_parse_help(arg, true);
@@ -1340,6 +2039,8 @@ int arg_parse_configs(Arg *arg) {
 void arg_parse_enable_config_print(Arg *arg) {
     ASSERT_ARG(arg);
     if(!arg->builtin.config_use_builtin) return;
+    /* parsing again, e.g. after arg_reset */
+    if(argx_group_get(&arg->env, so("CONFIG_PRINT"))) return;
     argx_builtin_env_config(arg);
 }
 
@@ -1347,39 +2048,83 @@ int arg_parse_check_required(Argx *argx) {
     ASSERT_ARG(argx);
     ASSERT_ARG(argx->group_p);
     Arg *arg = argx->group_p->arg;
-    if(argx->attr.is_required && !argx->sources) {
+    if(argx->attr.is_required && !argx_is_set(argx)) {
         arg_parse_error(arg, &(Arg_Stream){ .source = ARGX_SOURCE_POSTCHK }, ARG_PARSE_ERROR_MISSING_REQUIRED, argx);
         return -1;
     }
     return 0;
 }
 
-int arg_parse_check_required_group(Argx_Group *group) {
-    if(!group) return 0;
+int arg_parse_check_required_all(Arg *arg) {
     int status = 0;
-    for(Argx **it = group->list; it < array_itE(group->list); ++it) {
-        ASSERT_ARG(it);
-        Argx *argx = *it;
-        ASSERT_ARG(argx);
-        if(argx->id == ARGX_TYPE_GROUP) {
-            if(!argx->group_s) continue;
-            status |= arg_parse_check_required_group(argx->group_s);
-        } else {
-            status |= arg_parse_check_required(argx);
-        }
+    for(Argx *it = arg->required; it; it = it->required_next) {
+        /* positional arguments complain on their own */
+        if(argx_is_subgroup_of_root(it, &arg->pos)) continue;
+        status |= arg_parse_check_required(it);
         if(status) break;
     }
     return status;
 }
 
-int arg_parse_check_required_all(Arg *arg) {
-    int status = 0;
-    for(Argx_Group **group = arg->opts; group < array_itE(arg->opts); ++group) {
-        ASSERT_ARG(group);
-        arg_parse_check_required_group(*group);
+/* how many following values an argx takes on the command line, -1 if that can't be told without parsing */
+int arg_parse_argx_n_values(struct Argx *argx) {
+    switch(argx->id) {
+        case ARGX_TYPE_NONE:
+        case ARGX_TYPE_BOOL:   /* only takes true/false, never an option */
+        case ARGX_TYPE_SWITCH: return 0;
+        case ARGX_TYPE_REST:   return -1;
+        case ARGX_TYPE_GROUP: {
+            Argx_Group *sub = argx_group_sub(argx);
+            if(!sub) return -1;
+            switch(sub->id) {
+                case ARGX_GROUP_ENUM:
+                case ARGX_GROUP_FLAGS: return 1;
+                default: return -1;
+            }
+        } break;
+        default: return 1;
     }
-    arg_parse_check_required_group(&arg->env);
-    return status;
+}
+
+/* cheap look at argv, without converting or setting anything.
+ * returns true if the version gets printed for sure, so configs can't influence the outcome */
+bool arg_parse_preflight_version(struct Arg *arg, const int argc, const char **argv) {
+    ASSERT_ARG(arg);
+    Argx *version = arg->builtin.version_argx;
+    if(!version) return false;
+    Argx *pos = arg->pos.list;
+    int skip = 0;
+    for(int i = 1; i < argc; ++i) {
+        if(skip) {
+            --skip;
+            continue;
+        }
+        So carg = so_l((char *)argv[i]);
+        if(!so_cmp(carg, so("--"))) return false;
+        if(!so_cmp0(carg, so("--"))) {
+            So value = SO;
+            So opt = so_split_ch(so_i0(carg, 2), '=', &value);
+            Argx *argx = arg_get_opt(arg, opt);
+            if(!argx) return false;
+            if(argx == version) return true;
+            int n = arg_parse_argx_n_values(argx);
+            if(n < 0) return false;
+            if(so_len(opt) + 2 == so_len(carg)) skip += n;
+        } else if(so_at0(carg) == '-' && so_len(carg) > 1) {
+            for(size_t j = 1; j < so_len(carg); ++j) {
+                Argx *argx = arg_parse_get_shortopt(arg, so_at(carg, j));
+                if(!argx) return false;
+                if(argx == version) return true;
+                int n = arg_parse_argx_n_values(argx);
+                if(n < 0) return false;
+                skip += n;
+            }
+        } else {
+            if(!pos || pos->id == ARGX_TYPE_GROUP || pos->id == ARGX_TYPE_REST) return false;
+            pos = pos->next;
+        }
+    }
+    return false;
 }
 
 int arg_parse(struct Arg *arg, const int argc, const char **argv, bool *quit_early) {
@@ -1397,12 +2142,27 @@ int arg_parse(struct Arg *arg, const int argc, const char **argv, bool *quit_ear
 
     if(!status) status = arg_parse_environment(arg);
     if(arg->builtin.color != ARG_BUILTIN_COLOR_ON && arg->builtin.config_print_selected) arg->builtin.color_off = true;
+    if(arg->builtin.compgen_script) {
+        So script = SO;
+        arg_compgen_script(arg, &script, so_len(arg->config.program) ? arg->config.program : so_l(argv[0]));
+        so_print(script);
+        so_free(&script);
+        arg->builtin.quit_early = true;
+    }
     if(arg->builtin.quit_early) goto defer;
 
+    /* compgen and version never show values, don't bother with configs */
+    bool preflight = arg->builtin.compgen || arg->builtin.batch || arg_parse_preflight_version(arg, argc, argv);
+
     bool fatal_config = false;
-    arg_parse_configs(arg);
+    if(!preflight) arg_parse_configs(arg);
+    if(!status) status = arg_parse_environment_prefixed(arg);
     if(!status) status = arg_parse_stdin(arg, argc, argv);
     if(arg->builtin.quit_early || fatal_config) goto defer;
+    if(arg->builtin.compgen) goto defer;
+
+    /* layered: every layer got parsed, convert the assignments that won */
+    if(!status && arg->config.layered) status = static_arg_resolve(arg, false);
 
     if(!status) status = arg_parse_setref(arg);
 
@@ -1418,12 +2178,91 @@ defer:
 
     *quit_early |= arg->builtin.quit_early || arg->builtin.quit_when_all_parsed;
 
-    status |= arg_parse_help(arg, *quit_early);
+    /* lazy values have to be converted to validate or print them */
+    if(arg->builtin.batch || arg->builtin.config_print_selected) {
+        status |= arg_resolve(arg);
+    }
 
-    if(arg->builtin.compgen) *quit_early = true;
+    if(arg->builtin.batch) {
+        status |= (arg->help.error || arg->builtin.error_id);
+    } else {
+        status |= arg_parse_help(arg, *quit_early);
+    }
+
+    if(arg->builtin.compgen) {
+        arg_compgen_cache_write(arg);
+        *quit_early = true;
+    }
 
     return status;
 }
 
+/* split a command line into null terminated words, with quotes and backslashes like a shell (no expansions).
+ * nonzero if a quote never ends */
+static int static_arg_parse_batch_words(So *buf, size_t **offs, So line) {
+    bool in_word = false;
+    char quote = 0;
+    for(size_t i = 0; i < so_len(line); ++i) {
+        char c = so_at(line, i);
+        if(!quote && (c == ' ' || c == '\t' || c == '\r')) {
+            if(in_word) so_push(buf, 0);
+            in_word = false;
+            continue;
+        }
+        if(!in_word) {
+            array_push(*offs, so_len(*buf));
+            in_word = true;
+        }
+        if(quote) {
+            if(c == quote) quote = 0;
+            else if(c == '\\' && quote == '"' && i + 1 < so_len(line)) so_push(buf, so_at(line, ++i));
+            else so_push(buf, c);
+        } else if(c == '\'' || c == '"') {
+            quote = c;
+        } else if(c == '\\' && i + 1 < so_len(line)) {
+            so_push(buf, so_at(line, ++i));
+        } else {
+            so_push(buf, c);
+        }
+    }
+    if(in_word) so_push(buf, 0);
+    return quote ? -1 : 0;
+}
+
+int arg_parse_batch(struct Arg *arg, So input, char delim, Arg_Batch_Function report, void *user) {
+    ASSERT_ARG(arg);
+    int failed = 0;
+    size_t line = 0;
+    So buf = SO;
+    arg->builtin.batch = true;
+    for(So cmd = SO; so_splice(input, &cmd, delim); ) {
+        ++line;
+        size_t *offs = 0;
+        const char **argv = 0;
+        so_clear(&buf);
+        int status = static_arg_parse_batch_words(&buf, &offs, cmd);
+        if(!array_len(offs)) continue;
+        /* only now, the buffer doesn't move anymore */
+        for(size_t i = 0; i < array_len(offs); ++i) {
+            array_push(argv, buf.str + array_at(offs, i));
+        }
+        arg_reset(arg);
+        if(status) {
+            /* don't guess where the quote should have ended */
+            arg->builtin.error_id = ARG_PARSE_ERROR_MISSING_STRING_DELIM;
+        } else {
+            bool quit_early = false;
+            status = arg_parse(arg, (int)array_len(argv), argv, &quit_early);
+        }
+        if(status) ++failed;
+        if(report) report(arg, line, cmd, status, arg->builtin.error_id, user);
+        array_free(offs);
+        array_free(argv);
+    }
+    arg->builtin.batch = false;
+    so_free(&buf);
+    return failed;
+}
+
 /* parsing entry points }}} */
 
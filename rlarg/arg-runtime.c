@@ -1,13 +1,24 @@
 #include "../rlarg.h"
 #include "arg.h"
 
+/* parallel callbacks may call these at the same time */
+static void static_arg_runtime_lock(Arg *arg) {
+    if(arg->lock) pthread_mutex_lock(arg->lock);
+}
+
+static void static_arg_runtime_unlock(Arg *arg) {
+    if(arg->lock) pthread_mutex_unlock(arg->lock);
+}
+
 void arg_runtime_quit_early(struct Argx *argx, bool val) {
     if(!argx) return;
     if(!val) return;
     Argx_Group *group = argx->group_p;
     ASSERT_ARG(group);
     Arg *arg = group->arg;
+    static_arg_runtime_lock(arg);
     arg->builtin.quit_early = val;
+    static_arg_runtime_unlock(arg);
 }
 
 void arg_runtime_quit_when_all_parsed(struct Argx *argx, bool val) {
@@ -16,7 +27,9 @@ void arg_runtime_quit_when_all_parsed(struct Argx *argx, bool val) {
     Argx_Group *group = argx->group_p;
     ASSERT_ARG(group);
     Arg *arg = group->arg;
+    static_arg_runtime_lock(arg);
     arg->builtin.quit_when_all_parsed = val;
+    static_arg_runtime_unlock(arg);
 }
 
 void arg_runtime_set_parse_error_message(struct Argx *argx, char *fmt, ...) {
@@ -24,10 +37,12 @@ void arg_runtime_set_parse_error_message(struct Argx *argx, char *fmt, ...) {
     Argx_Group *group = argx->group_p;
     ASSERT_ARG(group);
     Arg *arg = group->arg;
+    static_arg_runtime_lock(arg);
     so_clear(&arg->builtin.custom_err_msg);
     va_list va;
     va_start(va, fmt);
     so_fmt_va(&arg->builtin.custom_err_msg, fmt, va);
     va_end(va);
+    static_arg_runtime_unlock(arg);
 }
 
@@ -41,16 +41,28 @@ void arg_stream_from_stdin(Arg_Stream *stream, const int argc, const char **argv
     ASSERT_ARG(argv);
     ASSERT_ARG(argc);
     ASSERT_ARG(argc >= 0);
-    for(size_t i = 1; i < (size_t)argc; ++i) {
-        vso_push(&stream->vso, so_l((char *)argv[i]));
-    }
+    /* view into argv, nothing gets copied */
+    stream->argv = argv + 1;
+    stream->argc = (size_t)argc - 1;
+}
+
+size_t arg_stream_len(Arg_Stream *stream) {
+    ASSERT_ARG(stream);
+    if(stream->argv) return stream->argc;
+    return array_len(stream->vso);
+}
+
+So arg_stream_at(Arg_Stream *stream, size_t i) {
+    ASSERT_ARG(stream);
+    if(stream->argv) return so_l((char *)stream->argv[i]);
+    return array_at(stream->vso, i);
 }
 
 bool arg_stream_get_next(Arg_Stream *stream, So *val, bool *compgen_flags) {
     ASSERT_ARG(stream);
     ASSERT_ARG(val);
     if(!arg_stream_advance(stream)) return false;
-    So carg = array_at(stream->vso, stream->i);
+    So carg = arg_stream_at(stream, stream->i);
     if(!stream->skip_flag_check) {
         if(stream->i_split) {
             stream->carg = so_i0(carg, stream->i_split);
@@ -72,10 +84,10 @@ bool arg_stream_get_next(Arg_Stream *stream, So *val, bool *compgen_flags) {
 }
 
 bool arg_stream_advance(Arg_Stream *stream) {
-    size_t len = array_len(stream->vso);
+    size_t len = arg_stream_len(stream);
     bool next_i = false;
     if(stream->carg.str && !stream->not_consumed && stream->i < len) {
-        So carg = array_at(stream->vso, stream->i);
+        So carg = arg_stream_at(stream, stream->i);
         if(stream->carg.str == carg.str) {
             if(stream->carg.len < carg.len) {
                 /* probably a split on = */
@@ -34,6 +34,8 @@ typedef struct Arg_Stream_Source {
 
 typedef struct Arg_Stream {
     VSo vso;
+    const char **argv;      /* if set, read from here instead of vso (not copied) */
+    size_t argc;
     size_t i, i_split;
     bool skip_flag_check;   /* set true once we encounter '--' */
     bool not_consumed;
@@ -47,10 +49,14 @@ typedef struct Arg_Stream {
 
 void arg_stream_free(Arg_Stream *stream);
 void arg_stream_source_free(Arg_Stream_Source *source);
+void arg_stream_source_so(So *out, Arg_Stream_Source *src);
 void arg_stream_clear(Arg_Stream *stream);
 
 void arg_stream_from_stdin(Arg_Stream *stream, const int argc, const char **argv);
 
+size_t arg_stream_len(Arg_Stream *stream);
+So arg_stream_at(Arg_Stream *stream, size_t i);
+
 bool arg_stream_get_next(Arg_Stream *stream, So *val, bool *compgen_flags);
 bool arg_stream_advance(Arg_Stream *stream);
 void arg_stream_not_consumed(Arg_Stream *stream);
@@ -8,6 +8,7 @@
 
 #include <rlso.h>
 #include <rlc.h>
+#include <pthread.h>
 
 // TODO: those below are all unused
 #define ARG_SPACING_HINT_WRAP               40
@@ -20,6 +21,9 @@
 #define ARG_SPACING_VALUE_WRAP_DELIM        40
 
 void arg_init_al(Arg_Rice *rice, struct Arg *arg, So_Align_Cache *alc, bool no_default); // TODO: should go into arg-core.h
+Argx *arg_storage_argx(struct Arg *arg);
+Argx_Group *arg_storage_group(struct Arg *arg);
+void arg_required_push(struct Arg *arg, Argx *argx);
 
 typedef struct Arg_Config {
     So program;
@@ -32,8 +36,23 @@ typedef struct Arg_Config {
         int c;      // spacing until short option
         int opt;    // spacing until long option
     } bounds;
+    struct {
+        unsigned char *buf; /* caller provided, see arg_config_set_storage */
+        size_t n_argx;
+        size_t n_group;
+    } storage;
+    bool lazy;      /* every argx behaves as with argx_attr_lazy */
+    bool layered;   /* see arg_config_set_layered */
+    So env_prefix;  /* see arg_config_set_env_prefix */
+    size_t parallel_workers; /* see arg_config_set_parallel_workers */
 } Arg_Config;
 
+typedef struct Arg_Env_Value {
+    Argx *argx;
+    So val;
+    size_t i;       /* index within environ */
+} Arg_Env_Value;
+
 typedef struct Arg_Help_Source {
     size_t i;
     Argx *last;
@@ -79,17 +98,32 @@ typedef struct Arg {
     Arg_Print print;
     Arg_Config config;
 
-    Argx_Groups opts;   /* groups of long options */
+    Argx_Group *opts;   /* groups of long options, continue via group->next */
+    Argx_Group *opts_last;
+    Argx_Group *subcommand;  /* options of the selected subcommand, see argx_group_subcommand */
     Argx_Group pos;     /* positional arguments */
     Argx_Group env;     /* environment variables */
 
+    struct {
+        size_t n_argx;  /* used slots of config.storage */
+        size_t n_group;
+    } storage;
+
     size_t i_pos;       /* index of positional argument parse status */
+    Argx *pos_next;     /* the positional at i_pos, so it's not looked up from the start of the list */
 
     T_Argx t_pos;       /* root of positional arguments */
     T_Argx t_env;       /* root of environment variables */
     T_Argx t_opt;       /* root of long options -> delve into groups */
 
     Argx_Callback_Queue *queue;   /* any callback that we encountered */
+    pthread_mutex_t *lock;        /* set while parallel callbacks run */
+    Argx *required;               /* every argx with argx_attr_required, continue via argx->required_next */
+    Argx *required_last;
+    Argx_Group *dirty_flags;      /* flag groups where a flag got set while parsing, continue via group->dirty */
+    bool setref_all;              /* references aren't written yet (arg_clone), visit every argx once */
+    Arg_Env_Value *env_found;     /* registered variables in environ, sorted by argx, while parsing */
+    Arg_Env_Value *env_prefixed;  /* variables mapped by config.env_prefix, parsed after the configs */
     Arg_Stream stream_in;
     size_t nb_source;
 
@@ -99,15 +133,22 @@ typedef struct Arg {
         bool compgen;               /* main trigger for compgen */
         bool compgen_flags;         /* only true has an effect. forces the generation of flags / options TODO I think is unused... */
         bool compgen_done;          /* helps us only printin one single compgen instance */
+        So compgen_word;            /* word being completed, only matching candidates get printed */
+        bool compgen_script;        /* print a bash completion script instead of parsing */
+        So compgen_cache;           /* path of the completion cache, see arg_compgen_cached */
         bool config_print_selected; // TODO: should probably rename to config_print; or smth. env_config_print?
         bool config_use_builtin;    /* instruct to generate groups of all options right before arg_parse ... */
         Arg_Builtin_Color_List color;  /* control color mode */
         bool color_off;             /* need this bool due to So_Fx */
         Argx *sources_argx;
+        Argx *version_argx;
         VSo sources_vso;        /* visible vso sources */
+        VSo sources_default;    /* sources registered via argx_builtin_opt_source */
         VSo sources_content;    /* content of sources */
         VSo sources_paths;      /* paths to sources */
         So custom_err_msg;
+        bool batch;                 /* see arg_parse_batch: no output, no configs, only validating callbacks */
+        Arg_Parse_Error_List error_id;  /* first error of the last parse */
     } builtin;
 
     struct {
@@ -14,6 +14,9 @@ void argx_attr_configurable(struct Argx *argx, bool configurable) {
 
 void argx_attr_required(struct Argx *argx, bool required) {
     ASSERT_ARG(argx);
+    ASSERT_ARG(argx->group_p);
+    Arg *arg = argx->group_p->arg;
+    if(required) arg_required_push(arg, argx);
     argx->attr.is_required = required;
 }
 
@@ -22,17 +25,32 @@ void argx_attr_callback_skip_compgen(struct Argx *argx, bool skip) {
     argx->attr.callback_skip_compgen = skip;
 }
 
+void argx_attr_callback_batch(struct Argx *argx, bool run) {
+    ASSERT_ARG(argx);
+    argx->attr.callback_batch = run;
+}
+
 void argx_attr_explicit_bool(struct Argx *argx, bool explicit) {
     ASSERT_ARG(argx);
     ASSERT(argx->id == ARGX_TYPE_BOOL, "expect bool argx");
     argx->attr.is_explicit_bool = explicit;
 }
 
+void argx_attr_lazy(struct Argx *argx, bool lazy) {
+    ASSERT_ARG(argx);
+    argx->attr.is_lazy = lazy;
+}
+
 void argx_attr_fatal_config_error(struct Argx *argx, bool fatal) {
     ASSERT_ARG(argx);
     argx->attr.is_fatal_config_error = fatal;
 }
 
+void argx_attr_unique_keys(struct Argx *argx, bool unique) {
+    ASSERT_ARG(argx);
+    argx->attr.is_unique_keys = unique;
+}
+
 bool argx_attr_is_explicit_bool(struct Argx *argx) {
     ASSERT_ARG(argx->group_p);
     ASSERT_ARG(argx->group_p->arg);
@@ -11,6 +11,13 @@ typedef struct Argx_Attr {
     bool is_explicit_bool;
     bool is_fatal_config_error;
     bool callback_skip_compgen;
+    bool callback_batch;    /* the callback only validates, arg_parse_batch calls it too */
+    bool is_lazy;
+    bool is_bitset;     /* bool array as Argx_Bits, see argx_type_array_bits */
+    bool is_range;      /* size array as Argx_Range, see argx_type_array_range */
+    bool is_set;        /* string array as Argx_So_Set, see argx_type_set_so */
+    bool is_map;        /* string array as Argx_So_Map, see argx_type_map_so */
+    bool is_unique_keys;
     int val_enum;
     So switch_arg;
 } Argx_Attr;
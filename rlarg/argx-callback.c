@@ -1,5 +1,6 @@
 #include "argx.h"
 #include "argx-callback.h"
+#include "arg.h"
 
 void argx_callback(struct Argx *argx, Argx_Function func, void *user, Argx_Priority_List priority) {
     ASSERT_ARG(argx);
@@ -9,3 +10,141 @@ void argx_callback(struct Argx *argx, Argx_Function func, void *user, Argx_Prior
     argx->callback.priority = priority;
 }
 
+/* true if argx is, or runs after, on */
+static bool static_argx_callback_depends(Argx *argx, Argx *on) {
+    if(argx == on) return true;
+    Argx **afterE = array_itE(argx->callback.after);
+    for(Argx **after = argx->callback.after; after < afterE; ++after) {
+        if(static_argx_callback_depends(*after, on)) return true;
+    }
+    return false;
+}
+
+void argx_callback_after(struct Argx *argx, struct Argx *before) {
+    ASSERT_ARG(argx);
+    ASSERT_ARG(before);
+    if(static_argx_callback_depends(before, argx)) {
+        ABORT("trying to run the callback of '%.*s' after '%.*s', which would never start", SO_F(argx->opt), SO_F(before->opt));
+    }
+    array_push(argx->callback.after, before);
+}
+
+/* parallel callbacks {{{ */
+
+typedef enum {
+    ARGX_CALLBACK_PENDING,
+    ARGX_CALLBACK_RUNNING,
+    ARGX_CALLBACK_DONE,
+} Argx_Callback_State_List;
+
+typedef struct Argx_Callback_Pool {
+    Arg *arg;
+    Argx_Callback_Queue **jobs;
+    Argx_Callback_State_List *state;
+    int *result;
+    size_t n_pending;
+    size_t n_running;
+    bool stop;      /* a callback failed or wants to quit: start nothing new */
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} Argx_Callback_Pool;
+
+static bool static_argx_callback_ready(Argx_Callback_Pool *pool, size_t i) {
+    size_t len = array_len(pool->jobs);
+    Argx **afterE = array_itE(pool->jobs[i]->argx->callback.after);
+    for(Argx **after = pool->jobs[i]->argx->callback.after; after < afterE; ++after) {
+        for(size_t j = 0; j < len; ++j) {
+            if(pool->jobs[j]->argx != *after) continue;
+            if(pool->state[j] != ARGX_CALLBACK_DONE) return false;
+        }
+    }
+    return true;
+}
+
+static void *static_argx_callback_worker(void *user) {
+    Argx_Callback_Pool *pool = user;
+    size_t len = array_len(pool->jobs);
+    pthread_mutex_lock(&pool->lock);
+    for(;;) {
+        size_t i = 0;
+        for(i = 0; !pool->stop && i < len; ++i) {
+            if(pool->state[i] != ARGX_CALLBACK_PENDING) continue;
+            if(static_argx_callback_ready(pool, i)) break;
+        }
+        if(!pool->stop && i < len) {
+            Argx_Callback_Queue *job = pool->jobs[i];
+            pool->state[i] = ARGX_CALLBACK_RUNNING;
+            --pool->n_pending;
+            ++pool->n_running;
+            pthread_mutex_unlock(&pool->lock);
+            int result = job->argx->callback.func(job->argx, job->argx->callback.user, job->so);
+            pthread_mutex_lock(&pool->lock);
+            pool->result[i] = result;
+            pool->state[i] = ARGX_CALLBACK_DONE;
+            --pool->n_running;
+            if(result || pool->arg->builtin.quit_early) pool->stop = true;
+            pthread_cond_broadcast(&pool->cond);
+            continue;
+        }
+        if(pool->stop || !pool->n_pending) break;
+        if(!pool->n_running) {
+            ABORT(ERR_UNREACHABLE("cyclic dependency between parallel callbacks"));
+        }
+        pthread_cond_wait(&pool->cond, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return 0;
+}
+
+int argx_callback_queue_parallel(struct Arg *arg) {
+    ASSERT_ARG(arg);
+    Argx_Callback_Pool pool = { .arg = arg };
+    Argx_Callback_Queue *itE = array_itE(arg->queue);
+    for(Argx_Callback_Queue *it = arg->queue; it < itE; ++it) {
+        if(it->argx->callback.priority != ARGX_PRIORITY_WHEN_ALL_VALID_PARALLEL) continue;
+        array_push(pool.jobs, it);
+    }
+    size_t len = array_len(pool.jobs);
+    if(!len) return 0;
+    pool.n_pending = len;
+    pool.state = calloc(len, sizeof(*pool.state));
+    pool.result = calloc(len, sizeof(*pool.result));
+    if(!pool.state || !pool.result) ABORT(ERR_MEMORY);
+    pthread_mutex_init(&pool.lock, 0);
+    pthread_cond_init(&pool.cond, 0);
+    arg->lock = &pool.lock;
+
+    /* one worker per callback unless capped; the calling thread is one of them */
+    size_t n_workers = arg->config.parallel_workers;
+    if(!n_workers || n_workers > len) n_workers = len;
+    pthread_t *workers = calloc(n_workers, sizeof(*workers));
+    if(!workers) ABORT(ERR_MEMORY);
+    size_t n_started = 0;
+    for(size_t i = 1; i < n_workers; ++i) {
+        /* fewer threads only means less overlap */
+        if(pthread_create(&workers[n_started], 0, static_argx_callback_worker, &pool)) break;
+        ++n_started;
+    }
+    static_argx_callback_worker(&pool);
+    for(size_t i = 0; i < n_started; ++i) {
+        pthread_join(workers[i], 0);
+    }
+
+    /* same outcome as running them in order */
+    int result = 0;
+    for(size_t i = 0; !result && i < len; ++i) {
+        result = pool.result[i];
+    }
+
+    arg->lock = 0;
+    pthread_cond_destroy(&pool.cond);
+    pthread_mutex_destroy(&pool.lock);
+    free(workers);
+    free(pool.result);
+    free(pool.state);
+    array_free(pool.jobs);
+    return result;
+}
+
+/* parallel callbacks }}} */
+
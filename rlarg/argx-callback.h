@@ -6,6 +6,7 @@ typedef struct Argx_Callback {
     Argx_Priority_List priority;
     Argx_Function func;
     void *user;
+    struct Argx **after;    /* parallel only: wait for these callbacks */
 } Argx_Callback;
 
 typedef struct Argx_Callback_Queue {
@@ -14,6 +15,8 @@ typedef struct Argx_Callback_Queue {
 } Argx_Callback_Queue;
 
 void argx_callback(struct Argx *argx, Argx_Function func, void *user, Argx_Priority_List priority);
+void argx_callback_after(struct Argx *argx, struct Argx *before);
+int argx_callback_queue_parallel(struct Arg *arg);
 
 #define ARGX_CALLBACK_H
 #endif /* ARGX_CALLBACK_H */
@@ -1,16 +1,26 @@
 #include "arg.h"
 
-void argx_groups_free(Argx_Groups group) {
-    argx_group_free(*group);
-    free(*group);
-}
-
 void argx_group_free(Argx_Group *group) {
-    t_argx_free(group->table);
-    v_argx_free(group->list);
+    if(group->table) {
+        t_argx_free(group->table);
+    } else {
+        /* caller storage, argx are not owned by a table */
+        for(Argx *it = group->list; it; it = it->next) {
+            argx_free(it);
+        }
+    }
+    if(group->arg->config.storage.buf) return;
     if(group->id != ARGX_GROUP_ROOT) {
         free(group->table);
         free(group);
+    } else if(group->is_subcommand) {
+        free(group->table);
+    }
+}
+
+void argx_group_reset(Argx_Group *group) {
+    for(Argx *it = group->list; it; it = it->next) {
+        argx_reset(it);
     }
 }
 
@@ -26,22 +36,171 @@ Argx_Group argx_group_init(struct Arg *arg, T_Argx *table, So name, Argx_Group_L
     return result;
 }
 
-struct Argx_Group *argx_group(struct Arg *arg, So name) {
+Argx_Group *argx_group_new(Argx *parent, Argx_Group_List id) {
+    ASSERT_ARG(parent);
+    ASSERT_ARG(parent->group_p);
+    Arg *arg = parent->group_p->arg;
+    Argx_Group *result = arg_storage_group(arg);
+    T_Argx *table = 0;
+    if(!result) {
+        NEW(T_Argx, table);
+        NEW(Argx_Group, result);
+    }
+    *result = argx_group_init(arg, table, parent->opt, id, parent);
+    return result;
+}
+
+/* sub group of an argx, built first if it was registered lazily */
+Argx_Group *argx_group_sub(Argx *argx) {
+    ASSERT_ARG(argx);
+    if(!argx->group_s && argx->lazy.populate) {
+        Argx_Group_Populate populate = argx->lazy.populate;
+        argx->lazy.populate = 0;
+        argx->group_s = argx_group_new(argx, argx->lazy.id);
+        populate(argx->group_s, argx->lazy.user);
+    }
+    return argx->group_s;
+}
+
+/* options of a subcommand, built into a root group of the same name when first selected.
+ * zero if the argx is no subcommand */
+Argx_Group *argx_group_subcommand(Argx *argx) {
+    ASSERT_ARG(argx);
+    if(argx->id != ARGX_TYPE_ENUM) return 0;
+    Arg *arg = argx->group_p->arg;
+    if(!argx->lazy.populate) {
+        /* built before, e.g. by an earlier parse */
+        Argx_Group *group = argx_group_get_opt(arg, argx->opt);
+        return group && group->is_subcommand ? group : 0;
+    }
+    Argx_Group_Populate populate = argx->lazy.populate;
+    argx->lazy.populate = 0;
+    Argx_Group *group = argx_group_root(arg, argx->opt, true);
+    populate(group, argx->lazy.user);
+    return group;
+}
+
+/* subcommand that was not yet built, looked up by name */
+Argx *arg_get_subcommand(struct Arg *arg, So name) {
+    ASSERT_ARG(arg);
+    for(Argx *pos = arg->pos.list; pos; pos = pos->next) {
+        if(!pos->group_s || pos->group_s->id != ARGX_GROUP_ENUM) continue;
+        for(Argx *it = pos->group_s->list; it; it = it->next) {
+            if(it->lazy.populate && !so_cmp(it->opt, name)) return it;
+        }
+    }
+    return 0;
+}
+
+/* build every subcommand, for anything that needs the whole schema at once */
+void arg_subcommands_build(struct Arg *arg) {
+    ASSERT_ARG(arg);
+    for(Argx *pos = arg->pos.list; pos; pos = pos->next) {
+        if(!pos->group_s || pos->group_s->id != ARGX_GROUP_ENUM) continue;
+        for(Argx *it = pos->group_s->list; it; it = it->next) {
+            argx_group_subcommand(it);
+        }
+    }
+}
+
+void argx_group_push(Argx_Group *group, Argx *argx) {
+    ASSERT_ARG(group);
+    ASSERT_ARG(argx);
+    if(group->list_last) {
+        group->list_last->next = argx;
+    } else {
+        group->list = argx;
+    }
+    group->list_last = argx;
+    ++group->list_len;
+}
+
+Argx *argx_group_at(Argx_Group *group, size_t i) {
+    ASSERT_ARG(group);
+    Argx *result = group->list;
+    while(result && i--) {
+        result = result->next;
+    }
+    return result;
+}
+
+Argx *argx_group_get(Argx_Group *group, So name) {
+    ASSERT_ARG(group);
+    if(group->table) {
+        return t_argx_get(group->table, name);
+    }
+    for(Argx *it = group->list; it; it = it->next) {
+        if(!so_cmp(it->opt, name)) return it;
+    }
+    return 0;
+}
+
+Argx *argx_group_get_short(Argx_Group *group, char c) {
+    ASSERT_ARG(group);
+    for(Argx *it = group->list; it; it = it->next) {
+        if(it->c == c) return it;
+    }
+    return 0;
+}
+
+/* long option of the groups that are no subcommand */
+Argx *arg_get_opt_shared(struct Arg *arg, So name) {
+    ASSERT_ARG(arg);
+    if(!arg->config.storage.buf) {
+        return t_argx_get(&arg->t_opt, name);
+    }
+    for(Argx_Group *group = arg->opts; group; group = group->next) {
+        if(group->is_subcommand) continue;
+        Argx *result = argx_group_get(group, name);
+        if(result) return result;
+    }
+    return 0;
+}
+
+/* long option as seen from the command line: shared ones, then those of the selected subcommand */
+Argx *arg_get_opt(struct Arg *arg, So name) {
+    ASSERT_ARG(arg);
+    Argx *result = arg_get_opt_shared(arg, name);
+    if(!result && arg->subcommand) {
+        result = argx_group_get(arg->subcommand, name);
+    }
+    return result;
+}
+
+Argx_Group *argx_group_root(struct Arg *arg, So name, bool is_subcommand) {
     ASSERT_ARG(arg);
     /* check if the group already exists */
-    for(Argx_Group **g = arg->opts; g < array_itE(arg->opts); ++g) {
-        if(!so_cmp((*g)->name, name)) {
-            return *g;
+    for(Argx_Group *g = arg->opts; g; g = g->next) {
+        if(!so_cmp(g->name, name)) {
+            return g;
         }
     }
     /* create new group */
-    Argx_Group *result;
-    NEW(Argx_Group, result);
-    *result = argx_group_init(arg, &arg->t_opt, name, ARGX_GROUP_ROOT, 0);
-    array_push(arg->opts, result);
+    Argx_Group *result = arg_storage_group(arg);
+    T_Argx *table = 0;
+    if(!result) {
+        NEW(Argx_Group, result);
+        if(is_subcommand) {
+            NEW(T_Argx, table);
+        } else {
+            table = &arg->t_opt;
+        }
+    }
+    *result = argx_group_init(arg, table, name, ARGX_GROUP_ROOT, 0);
+    result->is_subcommand = is_subcommand;
+    if(arg->opts_last) {
+        arg->opts_last->next = result;
+    } else {
+        arg->opts = result;
+    }
+    arg->opts_last = result;
     return result;
 }
 
+struct Argx_Group *argx_group(struct Arg *arg, So name) {
+    return argx_group_root(arg, name, false);
+}
+
 void argx_group_fmt_help(So *out, Argx_Group *group) {
     ASSERT_ARG(out);
     ASSERT_ARG(group);
@@ -49,8 +208,8 @@ void argx_group_fmt_help(So *out, Argx_Group *group) {
     so_fmt_fx(out, group->arg->rice.group, 0, "%.*s", SO_F(group->name));
     so_fmt_fx(out, group->arg->rice.group_delim, 0, ":");
     so_al_nl(out, group->arg->rice.whitespace, 1);
-    for(Argx **argx = group->list; argx < array_itE(group->list); ++argx) {
-        argx_fmt_help(out, *argx, false);
+    for(Argx *argx = group->list; argx; argx = argx->next) {
+        argx_fmt_help(out, argx, false);
         so_al_nl(out, group->arg->rice.whitespace, 1);
     }
 }
@@ -63,9 +222,9 @@ void argx_group_fmt_config(So *out, Argx_Group *group) {
     So_Align_Cache alc = {0};
     arg_init_al(&rice, group->arg, &alc, true);
 
-    for(Argx **argx = group->list; argx < array_itE(group->list); ++argx) {
+    for(Argx *argx = group->list; argx; argx = argx->next) {
         //so_fmt(out, "%.*s.", SO_F(group->name));
-        argx_fmt_config(out, &rice, *argx);
+        argx_fmt_config(out, &rice, argx);
     }
     so_push(out, '\n');
     so_al_cache_free(&alc);
@@ -75,14 +234,12 @@ Argx_Group *argx_group_get_opt(struct Arg *arg, So name) {
     ASSERT_ARG(arg);
 
     Argx_Group *result = 0;
-    Argx_Group **itE = array_itE(arg->opts);
-    for(Argx_Group **it = arg->opts; it < itE; ++it) {
-        if(!so_cmp((*it)->name, name)) {
-            result = *it;
+    for(Argx_Group *it = arg->opts; it; it = it->next) {
+        if(!so_cmp(it->name, name)) {
+            result = it;
             break;
         }
     }
 
     return result;
 }
-
@@ -12,18 +12,36 @@ typedef enum {
 
 typedef struct Argx_Group {
     struct Arg *arg;
-    V_Argx *list;
-    T_Argx *table;
+    struct Argx *list;          /* first argx, continue via argx->next */
+    struct Argx *list_last;
+    size_t list_len;
+    T_Argx *table;              /* zero if the group lives in caller storage */
     So name;
     Argx_Group_List id;
     struct Argx *parent;
+    struct Argx_Group *next;    /* next group of long options, if ARGX_GROUP_ROOT */
+    struct Argx_Group *dirty;   /* next flag group in arg->dirty_flags */
     bool config_print;
-} Argx_Group, **Argx_Groups;
+    bool is_bitmask;            /* flags are bits of parent->val.mask, see argx_group_flags_mask */
+    bool is_subcommand;         /* root group with options of its own, see argx_group_subcommand */
+} Argx_Group;
 
 Argx_Group argx_group_init(struct Arg *arg, T_Argx *table, So name, Argx_Group_List id, Argx *parent);
+Argx_Group *argx_group_new(Argx *parent, Argx_Group_List id);
 
 void argx_group_free(Argx_Group *group);
-void argx_groups_free(Argx_Groups group);
+void argx_group_reset(Argx_Group *group);
+void argx_group_push(Argx_Group *group, Argx *argx);
+Argx *argx_group_at(Argx_Group *group, size_t i);
+Argx *argx_group_get(Argx_Group *group, So name);
+Argx *argx_group_get_short(Argx_Group *group, char c);
+Argx *arg_get_opt(struct Arg *arg, So name);
+Argx *arg_get_opt_shared(struct Arg *arg, So name);
+Argx_Group *argx_group_root(struct Arg *arg, So name, bool is_subcommand);
+Argx_Group *argx_group_sub(Argx *argx);
+Argx_Group *argx_group_subcommand(Argx *argx);
+Argx *arg_get_subcommand(struct Arg *arg, So name);
+void arg_subcommands_build(struct Arg *arg);
 
 void argx_group_fmt_help(So *out, Argx_Group *group);
 void argx_group_fmt_config(So *out, Argx_Group *group);
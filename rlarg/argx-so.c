@@ -2,6 +2,7 @@
 #include "argx.h"
 #include "argx-group.h"
 #include "arg.h"
+#include "arg-float.h"
 #include <ctype.h>
 
 /* non vector types {{{ */
@@ -36,6 +37,26 @@ void argx_so_type_size(So *out, Arg_Rice *rice, Argx_Value_Union *val) {
     }
 }
 
+void argx_so_type_double(So *out, Arg_Rice *rice, Argx_Value_Union *val) {
+    ASSERT_ARG(out);
+    if(val->d) {
+        So tmp = SO;
+        arg_float_fmt_double(&tmp, *val->d);
+        so_fmt_fx(out, rice->val, 0, "%.*s", SO_F(tmp));
+        so_free(&tmp);
+    }
+}
+
+void argx_so_type_float(So *out, Arg_Rice *rice, Argx_Value_Union *val) {
+    ASSERT_ARG(out);
+    if(val->f) {
+        So tmp = SO;
+        arg_float_fmt_float(&tmp, *val->f);
+        so_fmt_fx(out, rice->val, 0, "%.*s", SO_F(tmp));
+        so_free(&tmp);
+    }
+}
+
 void argx_so_type_bool(So *out, Arg_Rice *rice, Argx_Value_Union *val) {
     ASSERT_ARG(out);
     if(val->b) {
@@ -105,6 +126,42 @@ void argx_so_like_array_string(So *out, Arg_Rice *rice, Argx_Value_Union *val, S
     }
 }
 
+/* same as a string array, in order of insertion */
+void argx_so_type_set_so(So *out, Arg_Rice *rice, Argx_Value_Union *val, So_Align al_ws, size_t array_max_items) {
+    ASSERT_ARG(out);
+    ASSERT_ARG(val);
+    if(!val->set) return;
+    VSo list = argx_so_set_list(*val->set);
+    argx_so_like_array_string(out, rice, &(Argx_Value_Union){ .vso = &list }, al_ws, array_max_items);
+}
+
+/* as an array of "key=value", which parses back the same */
+void argx_so_type_map_so(So *out, Arg_Rice *rice, Argx_Value_Union *val, So_Align al_ws, size_t array_max_items) {
+    ASSERT_ARG(out);
+    ASSERT_ARG(val);
+    if(!val->map) return;
+    Argx_So_Map *map = *val->map;
+    VSo pairs = 0;
+    for(size_t i = 0; i < argx_so_map_len(map); ++i) {
+        So pair = SO;
+        so_fmt(&pair, "%.*s=%.*s", SO_F(argx_so_map_key(map, i)), SO_F(argx_so_map_val(map, i)));
+        array_push(pairs, pair);
+    }
+    argx_so_like_array_string(out, rice, &(Argx_Value_Union){ .vso = &pairs }, al_ws, array_max_items);
+    vso_free(&pairs);
+}
+
+void argx_so_type_custom(So *out, Arg_Rice *rice, Argx *argx, Argx_Value_Union *val) {
+    ASSERT_ARG(out);
+    ASSERT_ARG(val);
+    const Argx_Type *type = argx->custom.type;
+    if(!val->any || !type->fmt) return;
+    So tmp = SO;
+    type->fmt(&tmp, val->any, argx->custom.user);
+    so_fmt_fx(out, rice->val, 0, "%.*s", SO_F(tmp));
+    so_free(&tmp);
+}
+
 void argx_so_type_array_int(So *out, Arg_Rice *rice, Argx_Value_Union *val, So_Align al_ws, size_t max_items) {
     ASSERT_ARG(out);
     ASSERT_ARG(val);
@@ -147,6 +204,56 @@ void argx_so_type_array_size(So *out, Arg_Rice *rice, Argx_Value_Union *val, So_
     }
 }
 
+void argx_so_type_array_double(So *out, Arg_Rice *rice, Argx_Value_Union *val, So_Align al_ws, size_t max_items) {
+    ASSERT_ARG(out);
+    ASSERT_ARG(val);
+    if(val->vd) {
+        So tmp = SO;
+        so_fmt_fx(out, rice->val_delim, 0, "[");
+        double *vE = array_itE(*val->vd);
+        double *vE2 = (max_items && array_len(*val->vd) > max_items) ? array_it(*val->vd, max_items) : vE;
+        for(double *v = *val->vd; v < vE2; ++v) {
+            so_al_nl(out, al_ws, 1);
+            so_clear(&tmp);
+            arg_float_fmt_double(&tmp, *v);
+            so_fmt_fx(out, rice->val, rice->val.align.i0 + 2, "%.*s", SO_F(tmp));
+            if(v + 1 < vE) so_fmt_fx(out, rice->val_delim, 0, ", ");
+        }
+        if(vE2 < vE) {
+            so_al_nl(out, al_ws, 1);
+            so_fmt_fx(out, rice->val_delim, rice->val.align.i0 + 2, "(+%zu more)", vE - vE2);
+        }
+        if(vE > *val->vd) so_al_nl(out, al_ws, 1);
+        so_fmt_fx(out, rice->val_delim, 0, "]");
+        so_free(&tmp);
+    }
+}
+
+void argx_so_type_array_float(So *out, Arg_Rice *rice, Argx_Value_Union *val, So_Align al_ws, size_t max_items) {
+    ASSERT_ARG(out);
+    ASSERT_ARG(val);
+    if(val->vf) {
+        So tmp = SO;
+        so_fmt_fx(out, rice->val_delim, 0, "[");
+        float *vE = array_itE(*val->vf);
+        float *vE2 = (max_items && array_len(*val->vf) > max_items) ? array_it(*val->vf, max_items) : vE;
+        for(float *v = *val->vf; v < vE2; ++v) {
+            so_al_nl(out, al_ws, 1);
+            so_clear(&tmp);
+            arg_float_fmt_float(&tmp, *v);
+            so_fmt_fx(out, rice->val, rice->val.align.i0 + 2, "%.*s", SO_F(tmp));
+            if(v + 1 < vE) so_fmt_fx(out, rice->val_delim, 0, ", ");
+        }
+        if(vE2 < vE) {
+            so_al_nl(out, al_ws, 1);
+            so_fmt_fx(out, rice->val_delim, rice->val.align.i0 + 2, "(+%zu more)", vE - vE2);
+        }
+        if(vE > *val->vf) so_al_nl(out, al_ws, 1);
+        so_fmt_fx(out, rice->val_delim, 0, "]");
+        so_free(&tmp);
+    }
+}
+
 void argx_so_type_array_bool(So *out, Arg_Rice *rice, Argx_Value_Union *val, So_Align al_ws, size_t max_items) {
     ASSERT_ARG(out);
     ASSERT_ARG(val);
@@ -168,6 +275,56 @@ void argx_so_type_array_bool(So *out, Arg_Rice *rice, Argx_Value_Union *val, So_
     }
 }
 
+/* as a literal that parses back: hex if whole digits, otherwise binary */
+void argx_so_type_array_bits(So *out, Arg_Rice *rice, Argx_Value_Union *val, size_t max_items) {
+    ASSERT_ARG(out);
+    ASSERT_ARG(val);
+    if(!val->bits) return;
+    Argx_Bits *bits = val->bits;
+    if(!bits->len) {
+        so_fmt_fx(out, rice->val_delim, 0, "[]");
+        return;
+    }
+    /* one item is a word */
+    size_t n = (max_items && bits->len > max_items * 64) ? max_items * 64 : bits->len;
+    bool hex = !(n % 4);
+    So digits = SO;
+    for(size_t i = 0; i < n; i += hex ? 4 : 1) {
+        if(!hex) {
+            so_push(&digits, argx_bits_get(bits, i) ? '1' : '0');
+            continue;
+        }
+        int d = 0;
+        for(size_t j = 0; j < 4; ++j) {
+            d = (d << 1) | argx_bits_get(bits, i + j);
+        }
+        so_push(&digits, "0123456789abcdef"[d]);
+    }
+    so_fmt_fx(out, rice->val, 0, "%s%.*s", hex ? "0x" : "0b", SO_F(digits));
+    if(n < bits->len) so_fmt_fx(out, rice->val_delim, 0, " (+%zu more)", bits->len - n);
+    so_free(&digits);
+}
+
+/* compact, the way it gets parsed: 0-63,128 */
+void argx_so_type_array_range(So *out, Arg_Rice *rice, Argx_Value_Union *val, size_t max_items) {
+    ASSERT_ARG(out);
+    ASSERT_ARG(val);
+    if(!val->vr) return;
+    size_t len = array_len(*val->vr);
+    if(!len) {
+        so_fmt_fx(out, rice->val_delim, 0, "[]");
+        return;
+    }
+    size_t n = (max_items && len > max_items) ? max_items : len;
+    for(size_t i = 0; i < n; ++i) {
+        Argx_Range *r = array_it(*val->vr, i);
+        if(i) so_fmt_fx(out, rice->val_delim, 0, ",");
+        if(r->lo == r->hi) so_fmt_fx(out, rice->val, 0, "%zi", r->lo);
+        else so_fmt_fx(out, rice->val, 0, "%zi-%zi", r->lo, r->hi);
+    }
+    if(n < len) so_fmt_fx(out, rice->val_delim, 0, " (+%zu more)", len - n);
+}
+
 void argx_so_type_array_color(So *out, Arg_Rice *rice, Argx_Value_Union *val, So_Align al_ws, size_t max_items) {
     ASSERT_ARG(out);
     ASSERT_ARG(val);
@@ -203,19 +360,18 @@ void argx_so_hint_enum(So *out, Arg_Rice *rice, char *hints, Argx *argx) {
     ASSERT_ARG(argx->group_p->arg);
     bool is_pos = argx_is_subgroup_of_root(argx, &argx->group_p->arg->pos);
     so_fmt_fx(out, rice->enum_delim, 0, "%c", hints[0]);
-    Argx **itE = array_itE(argx->group_s->list);
-    for(Argx **it = argx->group_s->list; it < itE; ++it) {
+    for(Argx *it = argx->group_s->list; it; it = it->next) {
         bool current_is_selected = false;
-        if(argx->val.i && *argx->val.i == (*it)->attr.val_enum) {
+        if(argx->val.i && *argx->val.i == it->attr.val_enum) {
             current_is_selected = !is_pos;
         }
         /* format hint */
         if(current_is_selected && rice) {
-            so_fmt_fx(out, rice->enum_set, 0, "%.*s", SO_F((*it)->opt));
+            so_fmt_fx(out, rice->enum_set, 0, "%.*s", SO_F(it->opt));
         } else {
-            so_fmt_fx(out, rice->enum_unset, 0, "%.*s", SO_F((*it)->opt));
+            so_fmt_fx(out, rice->enum_unset, 0, "%.*s", SO_F(it->opt));
         }
-        if(it + 1 < itE) so_fmt_fx(out, rice->enum_delim, 0, "|");
+        if(it->next) so_fmt_fx(out, rice->enum_delim, 0, "|");
     }
     so_fmt_fx(out, rice->enum_delim, 0, "%c", hints[1]);
 }
@@ -229,20 +385,19 @@ void argx_so_hint_flags(So *out, Arg_Rice *rice, char *hints, Argx *argx) {
     ASSERT_ARG(argx->group_p->arg);
     bool is_pos = argx_is_subgroup_of_root(argx, &argx->group_p->arg->pos);
     so_fmt_fx(out, rice->flag_delim, 0, "%c", hints[0]);
-    Argx **itE = array_itE(argx->group_s->list);
-    for(Argx **it = argx->group_s->list; it < itE; ++it) {
+    for(Argx *it = argx->group_s->list; it; it = it->next) {
         bool current_is_selected = false;
         /* check if iterator matches selected value */
-        if((*it)->val.b && *(*it)->val.b) {
+        if(it->val.b && *it->val.b) {
             current_is_selected = !is_pos;
         }
         /* format hint */
         if(current_is_selected) {
-            so_fmt_fx(out, rice->flag_set, 0, "%.*s", SO_F((*it)->opt));
+            so_fmt_fx(out, rice->flag_set, 0, "%.*s", SO_F(it->opt));
         } else {
-            so_fmt_fx(out, rice->flag_unset, 0, "%.*s", SO_F((*it)->opt));
+            so_fmt_fx(out, rice->flag_unset, 0, "%.*s", SO_F(it->opt));
         }
-        if(it + 1 < itE) so_fmt_fx(out, rice->flag_delim, 0, "|");
+        if(it->next) so_fmt_fx(out, rice->flag_delim, 0, "|");
     }
     so_fmt_fx(out, rice->flag_delim, 0, "%c", hints[1]);
 }
@@ -253,11 +408,10 @@ void argx_so_hint_options(So *out, Arg_Rice *rice, char *hints, Argx *argx) {
     ASSERT_ARG(hints);
     ASSERT_ARG(argx);
     so_fmt_fx(out, rice->subopt_delim, 0, "%c", hints[0]);
-    Argx **itE = array_itE(argx->group_s->list);
-    for(Argx **it = argx->group_s->list; it < itE; ++it) {
+    for(Argx *it = argx->group_s->list; it; it = it->next) {
         /* format hint */
-        so_fmt_fx(out, rice->subopt, 0, "%.*s", SO_F((*it)->opt));
-        if(it + 1 < itE) so_fmt_fx(out, rice->subopt_delim, 0, "|");
+        so_fmt_fx(out, rice->subopt, 0, "%.*s", SO_F(it->opt));
+        if(it->next) so_fmt_fx(out, rice->subopt_delim, 0, "|");
     }
     so_fmt_fx(out, rice->subopt_delim, 0, "%c", hints[1]);
 }
@@ -268,10 +422,9 @@ void argx_so_hint_sequence(So *out, Arg_Rice *rice, char *hints, Argx *argx) {
     ASSERT_ARG(hints);
     ASSERT_ARG(argx);
     so_fmt_fx(out, rice->sequence_delim, 0, "%c", hints[0]);
-    Argx **itE = array_itE(argx->group_s->list);
-    for(Argx **it = argx->group_s->list; it < itE; ++it) {
-        so_fmt_fx(out, rice->sequence, 0, "%.*s", SO_F((*it)->opt));
-        if(it + 1 < itE) so_fmt_fx(out, rice->sequence_delim, 0, ",");
+    for(Argx *it = argx->group_s->list; it; it = it->next) {
+        so_fmt_fx(out, rice->sequence, 0, "%.*s", SO_F(it->opt));
+        if(it->next) so_fmt_fx(out, rice->sequence_delim, 0, ",");
     }
     so_fmt_fx(out, rice->sequence_delim, 0, "%c", hints[1]);
 }
@@ -307,18 +460,31 @@ void argx_so_val(So *out, Arg_Rice *rice, Argx *argx, Argx_Value_Union *val, Arg
                 argx_so_type_array_color(out, rice_color, val, al_ws, opts->array_max_items);
             } break;
             case ARGX_TYPE_BOOL: {
-                argx_so_type_array_bool(out, rice, val, al_ws, opts->array_max_items);
+                if(argx->attr.is_bitset) argx_so_type_array_bits(out, rice, val, opts->array_max_items);
+                else argx_so_type_array_bool(out, rice, val, al_ws, opts->array_max_items);
             } break;
             case ARGX_TYPE_INT: {
                 argx_so_type_array_int(out, rice, val, al_ws, opts->array_max_items);
             } break;
             case ARGX_TYPE_SIZE: {
-                argx_so_type_array_size(out, rice, val, al_ws, opts->array_max_items);
+                if(argx->attr.is_range) argx_so_type_array_range(out, rice, val, opts->array_max_items);
+                else argx_so_type_array_size(out, rice, val, al_ws, opts->array_max_items);
+            } break;
+            case ARGX_TYPE_DOUBLE: {
+                argx_so_type_array_double(out, rice, val, al_ws, opts->array_max_items);
+            } break;
+            case ARGX_TYPE_FLOAT: {
+                argx_so_type_array_float(out, rice, val, al_ws, opts->array_max_items);
             } break;
             case ARGX_TYPE_REST:
             case ARGX_TYPE_URI:
             case ARGX_TYPE_STRING: {
-                argx_so_like_array_string(out, rice, val, al_ws, opts->array_max_items);
+                if(argx->attr.is_set) argx_so_type_set_so(out, rice, val, al_ws, opts->array_max_items);
+                else if(argx->attr.is_map) argx_so_type_map_so(out, rice, val, al_ws, opts->array_max_items);
+                else argx_so_like_array_string(out, rice, val, al_ws, opts->array_max_items);
+            } break;
+            case ARGX_TYPE_CUSTOM: {
+                argx_so_type_custom(out, rice, argx, val);
             } break;
             case ARGX_TYPE_SWITCH: {
                 ABORT(ERR_UNREACHABLE("vector of SWITCH is not supported, and thus you should never see this message"));
@@ -338,10 +504,23 @@ void argx_so_val(So *out, Arg_Rice *rice, Argx *argx, Argx_Value_Union *val, Arg
             default: ABORT(ERR_UNREACHABLE("unhandled id %u"), argx->id);
             case ARGX_TYPE_NONE: {
             } break;
+            case ARGX_TYPE_CUSTOM: {
+                argx_so_type_custom(out, rice, argx, val);
+            } break;
             case ARGX_TYPE_COLOR: {
                 argx_so_type_color(out, rice_color, val);
             } break;
-            case ARGX_TYPE_FLAG:
+            case ARGX_TYPE_FLAG: {
+                if(argx->group_p->is_bitmask) {
+                    /* the value is a bit of the parent */
+                    Argx *parent = argx->group_p->parent;
+                    uint64_t *mask = val == &argx->ref ? parent->ref.mask : parent->val.mask;
+                    bool bit = mask && ((*mask >> argx->attr.val_enum) & 1);
+                    if(mask) argx_so_type_bool(out, rice, &(Argx_Value_Union){ .b = &bit });
+                } else {
+                    argx_so_type_bool(out, rice, val);
+                }
+            } break;
             case ARGX_TYPE_BOOL: {
                 argx_so_type_bool(out, rice, val);
             } break;
@@ -351,6 +530,12 @@ void argx_so_val(So *out, Arg_Rice *rice, Argx *argx, Argx_Value_Union *val, Arg
             case ARGX_TYPE_SIZE: {
                 argx_so_type_size(out, rice, val);
             } break;
+            case ARGX_TYPE_DOUBLE: {
+                argx_so_type_double(out, rice, val);
+            } break;
+            case ARGX_TYPE_FLOAT: {
+                argx_so_type_float(out, rice, val);
+            } break;
             case ARGX_TYPE_URI:
             case ARGX_TYPE_STRING: {
                 argx_so_like_string(out, rice, val);
@@ -361,16 +546,15 @@ void argx_so_val(So *out, Arg_Rice *rice, Argx *argx, Argx_Value_Union *val, Arg
                         case ARGX_GROUP_FLAGS: {
                             bool is_pos = argx_is_subgroup_of_root(argx, &argx->group_p->arg->pos);
                             bool first = true;
-                            Argx **itE = array_itE(argx->group_s->list);
-                            for(Argx **it = argx->group_s->list; it < itE; ++it) {
+                            for(Argx *it = argx->group_s->list; it; it = it->next) {
                                 bool current_is_selected = false;
                                 /* check if iterator matches selected value */
-                                if((*it)->val.b && *(*it)->val.b) {
+                                if(argx_flag_is_set(it)) {
                                     current_is_selected = !is_pos;
                                 }
                                 if(current_is_selected) {
                                     if(!first) so_fmt_fx(out, rice->val_delim, 0, ",");
-                                    so_fmt_fx(out, rice->val, 0, "%.*s", SO_F((*it)->opt));
+                                    so_fmt_fx(out, rice->val, 0, "%.*s", SO_F(it->opt));
                                     first = false;
                                 }
                             }
@@ -378,16 +562,15 @@ void argx_so_val(So *out, Arg_Rice *rice, Argx *argx, Argx_Value_Union *val, Arg
                         case ARGX_GROUP_ENUM: {
                             bool is_pos = argx_is_subgroup_of_root(argx, &argx->group_p->arg->pos);
                             bool first = true;
-                            Argx **itE = array_itE(argx->group_s->list);
-                            for(Argx **it = argx->group_s->list; it < itE; ++it) {
+                            for(Argx *it = argx->group_s->list; it; it = it->next) {
                                 bool current_is_selected = false;
                                 /* check if iterator matches selected value */
-                                if(argx->val.i && *argx->val.i == (*it)->attr.val_enum) {
+                                if(argx->val.i && *argx->val.i == it->attr.val_enum) {
                                     current_is_selected = !is_pos;
                                 }
                                 if(current_is_selected) {
                                     if(!first) so_fmt_fx(out, rice->val_delim, 0, ",");
-                                    so_fmt_fx(out, rice->val, 0, "%.*s", SO_F((*it)->opt));
+                                    so_fmt_fx(out, rice->val, 0, "%.*s", SO_F(it->opt));
                                     first = false;
                                 }
                             }
@@ -415,6 +598,8 @@ bool argx_so_val_visible(Argx *argx, Argx_Value_Union *val) {
         result = (bool)(val->any);
         /* if switch, hide */
         if(argx->id == ARGX_TYPE_SWITCH) result = false;
+        /* if it can't be formatted, hide */
+        if(argx->id == ARGX_TYPE_CUSTOM && !argx->custom.type->fmt) result = false;
         /* if hidden, hide */
         if(argx->attr.is_hidden) result = false;
     }
@@ -423,7 +608,7 @@ bool argx_so_val_visible(Argx *argx, Argx_Value_Union *val) {
 
 bool argx_so_hint_visible(Argx *argx, Argx_Value_Union *val) {
     if(argx->id == ARGX_TYPE_NONE) return false;
-    if(argx->id == ARGX_TYPE_GROUP) return (bool)(argx->group_s);
+    if(argx->id == ARGX_TYPE_GROUP) return (bool)(argx->group_s || argx->lazy.populate);
     return true;
 }
 
@@ -482,9 +667,12 @@ void argx_so_hint(So *out, Arg_Rice *rice, Argx *argx, Argx_Value_Union *val, Ar
             case ARGX_TYPE_INT: {
                 argx_so_hint_generic(out, rice, hint, argx->hint.so);
             } break;
-            case ARGX_TYPE_SIZE: {
+            case ARGX_TYPE_SIZE:
+            case ARGX_TYPE_DOUBLE:
+            case ARGX_TYPE_FLOAT: {
                 argx_so_hint_generic(out, rice, hint, argx->hint.so);
             } break;
+            case ARGX_TYPE_CUSTOM:
             case ARGX_TYPE_REST:
             case ARGX_TYPE_URI:
             case ARGX_TYPE_STRING: {
@@ -519,16 +707,20 @@ void argx_so_hint(So *out, Arg_Rice *rice, Argx *argx, Argx_Value_Union *val, Ar
             case ARGX_TYPE_INT: {
                 argx_so_hint_generic(out, rice, hint, argx->hint.so);
             } break;
-            case ARGX_TYPE_SIZE: {
+            case ARGX_TYPE_SIZE:
+            case ARGX_TYPE_DOUBLE:
+            case ARGX_TYPE_FLOAT: {
                 argx_so_hint_generic(out, rice, hint, argx->hint.so);
             } break;
+            case ARGX_TYPE_CUSTOM:
             case ARGX_TYPE_URI:
             case ARGX_TYPE_STRING: {
                 argx_so_hint_generic(out, rice, hint, argx->hint.so);
             } break;
             case ARGX_TYPE_GROUP: {
-                if(argx->group_s) {
-                    switch(argx->group_s->id) {
+                Argx_Group *sub = argx_group_sub(argx);
+                if(sub) {
+                    switch(sub->id) {
                         case ARGX_GROUP_ENUM: {
                             argx_so_hint_enum(out, rice, hint, argx);
                         } break;
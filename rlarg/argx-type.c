@@ -1,5 +1,7 @@
 #include "arg.h"
 #include "argx.h"
+#include "arg-parse.h"
+#include <limits.h>
 
 /* TODO add check so that we will never add an invalid opt (e.g. has to be no format, can not have spaces, etc") */
 
@@ -24,6 +26,7 @@ void argx_type_so(struct Argx *argx, So *val, So *ref) {
         .id = ARGX_HINT_REQUIRED,
         .so = so("string"),
     };
+    arg_parse_setref_bind(argx);
 }
 
 void argx_type_uri(struct Argx *argx, So *val, So *ref) {
@@ -35,6 +38,7 @@ void argx_type_uri(struct Argx *argx, So *val, So *ref) {
         .id = ARGX_HINT_REQUIRED,
         .so = so("uri"),
     };
+    arg_parse_setref_bind(argx);
 }
 
 void argx_type_bool(struct Argx *argx, bool *val, bool *ref) {
@@ -46,6 +50,7 @@ void argx_type_bool(struct Argx *argx, bool *val, bool *ref) {
         .id = ARGX_HINT_REQUIRED,
         .so = so("bool"),
     };
+    arg_parse_setref_bind(argx);
 }
 
 void argx_type_int(struct Argx *argx, int *val, int *ref) {
@@ -57,6 +62,7 @@ void argx_type_int(struct Argx *argx, int *val, int *ref) {
         .id = ARGX_HINT_REQUIRED,
         .so = so("int"),
     };
+    arg_parse_setref_bind(argx);
 }
 
 void argx_type_size(struct Argx *argx, ssize_t *val, ssize_t *ref) {
@@ -68,6 +74,31 @@ void argx_type_size(struct Argx *argx, ssize_t *val, ssize_t *ref) {
         .id = ARGX_HINT_REQUIRED,
         .so = so("size"),
     };
+    arg_parse_setref_bind(argx);
+}
+
+void argx_type_double(struct Argx *argx, double *val, double *ref) {
+    ASSERT_ARG(argx);
+    argx->val.d = val;
+    argx->ref.d = ref;
+    argx->id = ARGX_TYPE_DOUBLE;
+    argx->hint = (Argx_Hint){
+        .id = ARGX_HINT_REQUIRED,
+        .so = so("double"),
+    };
+    arg_parse_setref_bind(argx);
+}
+
+void argx_type_float(struct Argx *argx, float *val, float *ref) {
+    ASSERT_ARG(argx);
+    argx->val.f = val;
+    argx->ref.f = ref;
+    argx->id = ARGX_TYPE_FLOAT;
+    argx->hint = (Argx_Hint){
+        .id = ARGX_HINT_REQUIRED,
+        .so = so("float"),
+    };
+    arg_parse_setref_bind(argx);
 }
 
 void argx_type_color(struct Argx *argx, Color *val, Color *ref) {
@@ -79,6 +110,7 @@ void argx_type_color(struct Argx *argx, Color *val, Color *ref) {
         .id = ARGX_HINT_REQUIRED,
         .so = so("color"),
     };
+    arg_parse_setref_bind(argx);
 }
 
 void argx_type_switch(struct Argx *argx) {
@@ -99,6 +131,7 @@ void argx_type_array_so(struct Argx *argx, VSo *val, VSo *ref) {
         .so = so("string-array"),
     };
     argx->attr.is_array = true;
+    arg_parse_setref_bind(argx);
 }
 
 void argx_type_array_uri(struct Argx *argx, VSo *val, VSo *ref) {
@@ -111,6 +144,7 @@ void argx_type_array_uri(struct Argx *argx, VSo *val, VSo *ref) {
         .so = so("uri-array"),
     };
     argx->attr.is_array = true;
+    arg_parse_setref_bind(argx);
 }
 
 void argx_type_array_bool(struct Argx *argx, bool **val, bool **ref) {
@@ -123,6 +157,305 @@ void argx_type_array_bool(struct Argx *argx, bool **val, bool **ref) {
         .so = so("bool-array"),
     };
     argx->attr.is_array = true;
+    arg_parse_setref_bind(argx);
+}
+
+void argx_type_array_bits(struct Argx *argx, Argx_Bits *val, Argx_Bits *ref) {
+    ASSERT_ARG(argx);
+    argx->val.bits = val;
+    argx->ref.bits = ref;
+    argx->id = ARGX_TYPE_BOOL;
+    argx->hint = (Argx_Hint){
+        .id = ARGX_HINT_REQUIRED,
+        .so = so("bits"),
+    };
+    argx->attr.is_array = true;
+    argx->attr.is_bitset = true;
+    arg_parse_setref_bind(argx);
+}
+
+void argx_bits_push(Argx_Bits *bits, bool bit) {
+    ASSERT_ARG(bits);
+    size_t i = bits->len++;
+    if(i / 64 >= array_len(bits->words)) array_push(bits->words, 0);
+    if(bit) bits->words[i / 64] |= (uint64_t)1 << (i % 64);
+}
+
+bool argx_bits_get(Argx_Bits *bits, size_t i) {
+    ASSERT_ARG(bits);
+    if(i >= bits->len) return false;
+    return (bits->words[i / 64] >> (i % 64)) & 1;
+}
+
+/* whole words while the end is aligned */
+void argx_bits_extend(Argx_Bits *bits, Argx_Bits *other) {
+    ASSERT_ARG(bits);
+    ASSERT_ARG(other);
+    size_t i = 0;
+    if(!(bits->len % 64)) {
+        size_t n = other->len / 64;
+        for(; i < n; ++i) {
+            array_push(bits->words, other->words[i]);
+        }
+        bits->len += n * 64;
+        i = n * 64;
+    }
+    for(; i < other->len; ++i) {
+        argx_bits_push(bits, argx_bits_get(other, i));
+    }
+}
+
+void argx_bits_free(Argx_Bits *bits) {
+    if(!bits) return;
+    array_free(bits->words);
+    bits->len = 0;
+}
+
+void argx_type_array_range(struct Argx *argx, Argx_Range **val, Argx_Range **ref) {
+    ASSERT_ARG(argx);
+    argx->val.vr = val;
+    argx->ref.vr = ref;
+    argx->id = ARGX_TYPE_SIZE;
+    argx->hint = (Argx_Hint){
+        .id = ARGX_HINT_REQUIRED,
+        .so = so("range"),
+    };
+    argx->attr.is_array = true;
+    argx->attr.is_range = true;
+    arg_parse_setref_bind(argx);
+}
+
+static int static_argx_range_cmp(const void *a, const void *b) {
+    const Argx_Range *x = a, *y = b;
+    return x->lo < y->lo ? -1 : (x->lo > y->lo);
+}
+
+static void static_argx_range_append(Argx_Range **ranges, Argx_Range r) {
+    size_t n = array_len(*ranges);
+    Argx_Range *last = n ? array_it(*ranges, n - 1) : 0;
+    if(last && (last->hi >= r.lo || (last->hi < SSIZE_MAX && last->hi + 1 == r.lo))) {
+        if(r.hi > last->hi) last->hi = r.hi;
+    } else {
+        array_push(*ranges, r);
+    }
+}
+
+/* other doesn't have to be sorted; one pass over both */
+void argx_range_merge(Argx_Range **ranges, Argx_Range *other) {
+    ASSERT_ARG(ranges);
+    size_t n = array_len(*ranges), m = array_len(other);
+    if(!m) return;
+    Argx_Range *sorted = 0;
+    array_extend(sorted, other);
+    qsort(sorted, m, sizeof(*sorted), static_argx_range_cmp);
+    Argx_Range *result = 0;
+    for(size_t i = 0, j = 0; i < n || j < m; ) {
+        if(j >= m || (i < n && (*ranges)[i].lo <= sorted[j].lo)) {
+            static_argx_range_append(&result, (*ranges)[i++]);
+        } else {
+            static_argx_range_append(&result, sorted[j++]);
+        }
+    }
+    array_free(sorted);
+    array_free(*ranges);
+    *ranges = result;
+}
+
+void argx_range_add(Argx_Range **ranges, ssize_t lo, ssize_t hi) {
+    ASSERT_ARG(ranges);
+    Argx_Range *one = 0;
+    array_push(one, ((Argx_Range){ .lo = lo, .hi = hi }));
+    argx_range_merge(ranges, one);
+    array_free(one);
+}
+
+bool argx_range_contains(Argx_Range *ranges, ssize_t i) {
+    size_t lo = 0, hi = array_len(ranges);
+    while(lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if(ranges[mid].hi < i) lo = mid + 1;
+        else if(ranges[mid].lo > i) hi = mid;
+        else return true;
+    }
+    return false;
+}
+
+/* the set doesn't own its strings */
+static void static_argx_so_set_keep_key(So so) {}
+static void static_argx_so_set_keep_index(size_t i) {}
+
+LUT_IMPLEMENT(T_So_Set, t_so_set, So, BY_VAL, size_t, BY_VAL, so_hash, so_cmp, static_argx_so_set_keep_key, static_argx_so_set_keep_index)
+
+void argx_type_set_so(struct Argx *argx, Argx_So_Set **val, Argx_So_Set **ref) {
+    ASSERT_ARG(argx);
+    argx->val.set = val;
+    argx->ref.set = ref;
+    argx->id = ARGX_TYPE_STRING;
+    argx->hint = (Argx_Hint){
+        .id = ARGX_HINT_REQUIRED,
+        .so = so("string-set"),
+    };
+    argx->attr.is_array = true;
+    argx->attr.is_set = true;
+    arg_parse_setref_bind(argx);
+}
+
+bool argx_so_set_add(Argx_So_Set **set, So so) {
+    ASSERT_ARG(set);
+    if(!*set) NEW(Argx_So_Set, *set);
+    size_t i = array_len((*set)->list);
+    if(!t_so_set_once(&(*set)->table, so, i)) return false;
+    array_push((*set)->list, so);
+    return true;
+}
+
+void argx_so_set_extend(Argx_So_Set **set, Argx_So_Set *other) {
+    ASSERT_ARG(set);
+    if(!other) return;
+    for(size_t i = 0; i < array_len(other->list); ++i) {
+        argx_so_set_add(set, array_at(other->list, i));
+    }
+}
+
+bool argx_so_set_has(Argx_So_Set *set, So so) {
+    if(!set) return false;
+    return t_so_set_get(&set->table, so);
+}
+
+size_t argx_so_set_len(Argx_So_Set *set) {
+    return set ? array_len(set->list) : 0;
+}
+
+VSo argx_so_set_list(Argx_So_Set *set) {
+    return set ? set->list : 0;
+}
+
+void argx_so_set_free(Argx_So_Set **set) {
+    ASSERT_ARG(set);
+    if(!*set) return;
+    t_so_set_free(&(*set)->table);
+    array_free((*set)->list);
+    free(*set);
+    *set = 0;
+}
+
+void argx_type_map_so(struct Argx *argx, Argx_So_Map **val, Argx_So_Map **ref) {
+    ASSERT_ARG(argx);
+    argx->val.map = val;
+    argx->ref.map = ref;
+    argx->id = ARGX_TYPE_STRING;
+    argx->hint = (Argx_Hint){
+        .id = ARGX_HINT_REQUIRED,
+        .so = so("key=value"),
+    };
+    argx->attr.is_array = true;
+    argx->attr.is_map = true;
+    arg_parse_setref_bind(argx);
+}
+
+Argx_So_Map_Item *argx_so_map_item(Argx_So_Map *map, So key) {
+    if(!map) return 0;
+    size_t *i = t_so_set_get(&map->table, key);
+    return i ? array_it(map->list, *i) : 0;
+}
+
+void argx_so_map_put(Argx_So_Map **map, So key, So val, Arg_Stream_Source src) {
+    ASSERT_ARG(map);
+    if(!*map) NEW(Argx_So_Map, *map);
+    if(src.id == ARG_STREAM_SOURCE_CONFIG) src.path = so_clone(src.path);
+    src.argx = 0;
+    Argx_So_Map_Item *item = argx_so_map_item(*map, key);
+    if(item) {
+        arg_stream_source_free(&item->source);
+        item->val = val;
+        item->source = src;
+    } else {
+        t_so_set_once(&(*map)->table, key, array_len((*map)->list));
+        array_push((*map)->list, ((Argx_So_Map_Item){ .key = key, .val = val, .source = src }));
+    }
+}
+
+void argx_so_map_extend(Argx_So_Map **map, Argx_So_Map *other) {
+    ASSERT_ARG(map);
+    if(!other) return;
+    for(size_t i = 0; i < array_len(other->list); ++i) {
+        Argx_So_Map_Item *item = array_it(other->list, i);
+        argx_so_map_put(map, item->key, item->val, item->source);
+    }
+}
+
+void argx_so_map_set(Argx_So_Map **map, So key, So val) {
+    argx_so_map_put(map, key, val, ARGX_SOURCE_REFVAL);
+}
+
+So *argx_so_map_get(Argx_So_Map *map, So key) {
+    Argx_So_Map_Item *item = argx_so_map_item(map, key);
+    return item ? &item->val : 0;
+}
+
+size_t argx_so_map_len(Argx_So_Map *map) {
+    return map ? array_len(map->list) : 0;
+}
+
+So argx_so_map_key(Argx_So_Map *map, size_t i) {
+    ASSERT(i < argx_so_map_len(map), "index %zu out of range", i);
+    return array_it(map->list, i)->key;
+}
+
+So argx_so_map_val(Argx_So_Map *map, size_t i) {
+    ASSERT(i < argx_so_map_len(map), "index %zu out of range", i);
+    return array_it(map->list, i)->val;
+}
+
+void argx_so_map_fmt_source(So *out, Argx_So_Map *map, So key) {
+    ASSERT_ARG(out);
+    Argx_So_Map_Item *item = argx_so_map_item(map, key);
+    if(item) arg_stream_source_so(out, &item->source);
+}
+
+static void static_argx_so_map_item_free(Argx_So_Map_Item *item) {
+    arg_stream_source_free(&item->source);
+}
+
+void argx_so_map_free(Argx_So_Map **map) {
+    ASSERT_ARG(map);
+    if(!*map) return;
+    t_so_set_free(&(*map)->table);
+    array_free_ext((*map)->list, static_argx_so_map_item_free);
+    free(*map);
+    *map = 0;
+}
+
+void argx_type_custom(struct Argx *argx, const Argx_Type *type, void *user, void *val, void *ref) {
+    ASSERT_ARG(argx);
+    ASSERT_ARG(type);
+    ASSERT(type->convert, "expect a converter for type <%.*s>", SO_F(type->hint));
+    ASSERT(!ref || type->size, "expect the size of type <%.*s> to copy its default", SO_F(type->hint));
+    argx->val.any = val;
+    argx->ref.any = ref;
+    argx->id = ARGX_TYPE_CUSTOM;
+    argx->custom.type = type;
+    argx->custom.user = user;
+    argx->hint = (Argx_Hint){
+        .id = ARGX_HINT_REQUIRED,
+        .so = type->hint,
+    };
+    arg_parse_setref_bind(argx);
+}
+
+void argx_type_array_custom(struct Argx *argx, const Argx_Type *type, void *user, void *val) {
+    ASSERT_ARG(argx);
+    ASSERT_ARG(type);
+    ASSERT(type->convert || type->convert_array, "expect a converter for type <%.*s>", SO_F(type->hint));
+    argx->val.any = val;
+    argx->id = ARGX_TYPE_CUSTOM;
+    argx->custom.type = type;
+    argx->custom.user = user;
+    argx->hint = (Argx_Hint){
+        .id = ARGX_HINT_REQUIRED,
+        .so = type->hint,
+    };
+    argx->attr.is_array = true;
 }
 
 void argx_type_array_int(struct Argx *argx, int **val, int **ref) {
@@ -135,6 +468,7 @@ void argx_type_array_int(struct Argx *argx, int **val, int **ref) {
         .so = so("int-array"),
     };
     argx->attr.is_array = true;
+    arg_parse_setref_bind(argx);
 }
 
 void argx_type_array_size(struct Argx *argx, ssize_t **val, ssize_t **ref) {
@@ -147,6 +481,33 @@ void argx_type_array_size(struct Argx *argx, ssize_t **val, ssize_t **ref) {
         .so = so("size-array"),
     };
     argx->attr.is_array = true;
+    arg_parse_setref_bind(argx);
+}
+
+void argx_type_array_double(struct Argx *argx, double **val, double **ref) {
+    ASSERT_ARG(argx);
+    argx->val.vd = val;
+    argx->ref.vd = ref;
+    argx->id = ARGX_TYPE_DOUBLE;
+    argx->hint = (Argx_Hint){
+        .id = ARGX_HINT_REQUIRED,
+        .so = so("double-array"),
+    };
+    argx->attr.is_array = true;
+    arg_parse_setref_bind(argx);
+}
+
+void argx_type_array_float(struct Argx *argx, float **val, float **ref) {
+    ASSERT_ARG(argx);
+    argx->val.vf = val;
+    argx->ref.vf = ref;
+    argx->id = ARGX_TYPE_FLOAT;
+    argx->hint = (Argx_Hint){
+        .id = ARGX_HINT_REQUIRED,
+        .so = so("float-array"),
+    };
+    argx->attr.is_array = true;
+    arg_parse_setref_bind(argx);
 }
 
 void argx_type_array_color(struct Argx *argx, Color **val, Color **ref) {
@@ -159,6 +520,7 @@ void argx_type_array_color(struct Argx *argx, Color **val, Color **ref) {
         .so = so("color-array"),
     };
     argx->attr.is_array = true;
+    arg_parse_setref_bind(argx);
 }
 
 struct Argx_Group *argx_group_enum(struct Argx *argx, int *val, int *ref) {
@@ -166,36 +528,58 @@ struct Argx_Group *argx_group_enum(struct Argx *argx, int *val, int *ref) {
     argx->val.i = val;
     argx->ref.i = ref;
     argx->id = ARGX_TYPE_GROUP;
-    T_Argx *table;
-    NEW(T_Argx, table);
-    NEW(Argx_Group, argx->group_s);
+    argx->group_s = argx_group_new(argx, ARGX_GROUP_ENUM);
     Argx_Group *group = argx->group_s;
-    *group = argx_group_init(argx->group_p->arg, table, argx->opt, ARGX_GROUP_ENUM, argx);
     argx->hint.id = ARGX_HINT_ENUM;
+    arg_parse_setref_bind(argx);
     return group;
 }
 
 struct Argx_Group *argx_group_options(struct Argx *argx) {
     ASSERT_ARG(argx);
     argx->id = ARGX_TYPE_GROUP;
-    T_Argx *table;
-    NEW(T_Argx, table);
-    NEW(Argx_Group, argx->group_s);
+    argx->group_s = argx_group_new(argx, ARGX_GROUP_OPTIONS);
     Argx_Group *group = argx->group_s;
     argx->hint.id = ARGX_HINT_OPTION;
-    *group = argx_group_init(argx->group_p->arg, table, argx->opt, ARGX_GROUP_OPTIONS, argx);
     return group;
 }
 
+void argx_group_options_lazy(struct Argx *argx, Argx_Group_Populate populate, void *user) {
+    ASSERT_ARG(argx);
+    ASSERT_ARG(populate);
+    argx->id = ARGX_TYPE_GROUP;
+    argx->lazy.populate = populate;
+    argx->lazy.user = user;
+    argx->lazy.id = ARGX_GROUP_OPTIONS;
+    argx->hint.id = ARGX_HINT_OPTION;
+}
+
+void argx_group_flags_lazy(struct Argx *argx, Argx_Group_Populate populate, void *user) {
+    ASSERT_ARG(argx);
+    ASSERT_ARG(populate);
+    argx->id = ARGX_TYPE_GROUP;
+    argx->lazy.populate = populate;
+    argx->lazy.user = user;
+    argx->lazy.id = ARGX_GROUP_FLAGS;
+    argx->hint.id = ARGX_HINT_FLAGS;
+}
+
 struct Argx_Group *argx_group_flags(struct Argx *argx) {
     ASSERT_ARG(argx);
     argx->id = ARGX_TYPE_GROUP;
-    T_Argx *table;
-    NEW(T_Argx, table);
-    NEW(Argx_Group, argx->group_s);
+    argx->group_s = argx_group_new(argx, ARGX_GROUP_FLAGS);
     Argx_Group *group = argx->group_s;
     argx->hint.id = ARGX_HINT_FLAGS;
-    *group = argx_group_init(argx->group_p->arg, table, argx->opt, ARGX_GROUP_FLAGS, argx);
+    return group;
+}
+
+struct Argx_Group *argx_group_flags_mask(struct Argx *argx, uint64_t *val, uint64_t *ref) {
+    ASSERT_ARG(argx);
+    Argx_Group *group = argx_group_flags(argx);
+    group->is_bitmask = true;
+    argx->val.mask = val;
+    argx->ref.mask = ref;
+    arg_parse_setref_bind(argx);
     return group;
 }
 
@@ -216,6 +600,8 @@ struct Argx_Group *argx_group_flags(struct Argx *argx) {
 
 ARGX_SWITCH_FLAG_IMPL(int,   int,     ARGX_TYPE_INT, i)
 ARGX_SWITCH_FLAG_IMPL(size,  ssize_t, ARGX_TYPE_SIZE, z)
+ARGX_SWITCH_FLAG_IMPL(double, double, ARGX_TYPE_DOUBLE, d)
+ARGX_SWITCH_FLAG_IMPL(float, float,   ARGX_TYPE_FLOAT, f)
 ARGX_SWITCH_FLAG_IMPL(bool,  bool,    ARGX_TYPE_BOOL, b)
 ARGX_SWITCH_FLAG_IMPL(so,    So,      ARGX_TYPE_STRING, so)
 ARGX_SWITCH_FLAG_IMPL(uri,   So,      ARGX_TYPE_URI, so)
@@ -224,6 +610,8 @@ ARGX_SWITCH_FLAG_IMPL(color, Color,   ARGX_TYPE_COLOR, c)
 
 ARGX_SWITCH_FLAG_IMPL(array_int,   int *,     ARGX_TYPE_INT, vi)
 ARGX_SWITCH_FLAG_IMPL(array_size,  ssize_t *, ARGX_TYPE_SIZE, vz)
+ARGX_SWITCH_FLAG_IMPL(array_double, double *, ARGX_TYPE_DOUBLE, vd)
+ARGX_SWITCH_FLAG_IMPL(array_float, float *,   ARGX_TYPE_FLOAT, vf)
 ARGX_SWITCH_FLAG_IMPL(array_bool,  bool *,    ARGX_TYPE_BOOL, vb)
 ARGX_SWITCH_FLAG_IMPL(array_so,    So *,      ARGX_TYPE_STRING, vso)
 ARGX_SWITCH_FLAG_IMPL(array_uri,   So *,      ARGX_TYPE_URI, vso)
@@ -255,12 +643,9 @@ void argx_switch_none(struct Argx *switch_argx, struct Argx *argx) {
 struct Argx_Group *argx_group_sequence(struct Argx *argx) {
     ASSERT_ARG(argx);
     argx->id = ARGX_TYPE_GROUP;
-    T_Argx *table;
-    NEW(T_Argx, table);
-    NEW(Argx_Group, argx->group_s);
+    argx->group_s = argx_group_new(argx, ARGX_GROUP_SEQUENCE);
     Argx_Group *group = argx->group_s;
     argx->hint.id = ARGX_HINT_SEQUENCE;
-    *group = argx_group_init(argx->group_p->arg, table, argx->opt, ARGX_GROUP_SEQUENCE, argx);
     return group;
 }
 
@@ -274,6 +659,15 @@ struct Argx *argx_enum_bind(struct Argx_Group *group, int val, So name, So desc)
     return x;
 }
 
+struct Argx *argx_subcommand(struct Argx_Group *group, int val, So name, So desc, Argx_Group_Populate populate, void *user) {
+    ASSERT_ARG(populate);
+    struct Argx *x = argx_enum_bind(group, val, name, desc);
+    x->lazy.populate = populate;
+    x->lazy.user = user;
+    x->lazy.id = ARGX_GROUP_ROOT;
+    return x;
+}
+
 struct Argx *argx_flag(struct Argx_Group *group, bool *val, bool *ref, So name, So desc) {
     struct Argx *x = argx_opt(group, 0, name, desc);
     argx_type_bool(x, val, ref);
@@ -281,3 +675,15 @@ struct Argx *argx_flag(struct Argx_Group *group, bool *val, bool *ref, So name,
     return x;
 }
 
+struct Argx *argx_flag_bit(struct Argx_Group *group, So name, So desc) {
+    ASSERT_ARG(group);
+    ASSERT(group->is_bitmask, "group has to be created with argx_group_flags_mask");
+    size_t bit = group->list_len;
+    if(bit >= 64) ABORT("a flag mask holds at most 64 flags: %.*s", SO_F(name));
+    struct Argx *x = argx_opt(group, 0, name, desc);
+    argx_type_bool(x, 0, 0);
+    x->id = ARGX_TYPE_FLAG;
+    x->attr.val_enum = (int)bit;
+    return x;
+}
+
@@ -1,9 +1,9 @@
 #include "arg.h"
 #include "argx.h"
 #include "argx-group.h"
+#include "arg-parse.h"
 
 void argx_free_v(Argx argx);
-void argx_free(Argx *argx);
 
 LUT_IMPLEMENT(T_Argx, t_argx, So, BY_VAL, Argx, BY_VAL, so_hash, so_cmp, so_free_v, argx_free_v)
 
@@ -17,19 +17,40 @@ void argx_switch_free(Argx_Switch *sw) {
     free(sw->val.any);
 }
 
+/* a value left at its default array shares it, see arg_parse_setval_argx */
+static void static_argx_unshare(Argx *argx) {
+    if(!argx->val.any || !argx->ref.any) return;
+    void **val = argx->val.any;
+    if(*val != *(void **)argx->ref.any) return;
+    *val = 0;
+    if(argx->attr.is_bitset) argx->val.bits->len = 0;
+}
+
 void argx_free(Argx *argx) {
     //printff("free argx: %.*s",SO_F(argx->opt));
     if(argx->attr.is_array) {
+        static_argx_unshare(argx);
         switch(argx->id) {
             default: ABORT(ERR_UNREACHABLE("unhandled id %u"), argx->id);
             case ARGX_TYPE_FLAG: ABORT(ERR_UNREACHABLE("array of FLAG unsupported (how did you reach this code?)"));
             case ARGX_TYPE_ENUM: ABORT(ERR_UNREACHABLE("array of ENUM unsupported (how did you reach this code?)"));
             case ARGX_TYPE_GROUP: ABORT(ERR_UNREACHABLE("array of GROUP unsupported (how did you reach this code?)"));
             case ARGX_TYPE_SWITCH: ABORT(ERR_UNREACHABLE("array of SWITCH unsupported (how did you reach this code?)"));
+            case ARGX_TYPE_CUSTOM: break; /* the container belongs to the caller */
             case ARGX_TYPE_NONE: {}
             case ARGX_TYPE_REST:
             case ARGX_TYPE_URI:
             case ARGX_TYPE_STRING: {
+                if(argx->attr.is_set) {
+                    if(argx->val.set) argx_so_set_free(argx->val.set);
+                    if(argx->ref.set) argx_so_set_free(argx->ref.set);
+                    break;
+                }
+                if(argx->attr.is_map) {
+                    if(argx->val.map) argx_so_map_free(argx->val.map);
+                    if(argx->ref.map) argx_so_map_free(argx->ref.map);
+                    break;
+                }
                 if(argx->val.vso) array_free(*argx->val.vso);
                 if(argx->ref.vso) array_free(*argx->ref.vso);
             } break;
@@ -41,7 +62,20 @@ void argx_free(Argx *argx) {
                 if(argx->val.vz) array_free(*argx->val.vz);
                 if(argx->ref.vz) array_free(*argx->ref.vz);
             } break;
+            case ARGX_TYPE_DOUBLE: {
+                if(argx->val.vd) array_free(*argx->val.vd);
+                if(argx->ref.vd) array_free(*argx->ref.vd);
+            } break;
+            case ARGX_TYPE_FLOAT: {
+                if(argx->val.vf) array_free(*argx->val.vf);
+                if(argx->ref.vf) array_free(*argx->ref.vf);
+            } break;
             case ARGX_TYPE_BOOL: {
+                if(argx->attr.is_bitset) {
+                    argx_bits_free(argx->val.bits);
+                    argx_bits_free(argx->ref.bits);
+                    break;
+                }
                 if(argx->val.vb) array_free(*argx->val.vb);
                 if(argx->ref.vb) array_free(*argx->ref.vb);
             } break;
@@ -53,35 +87,132 @@ void argx_free(Argx *argx) {
     } else {
         if(argx->id == ARGX_TYPE_SWITCH) {
             array_free_ext(argx->val.sw, argx_switch_free);
-        } else if(argx->id == ARGX_TYPE_GROUP) {
+        } else if(argx->id == ARGX_TYPE_GROUP && argx->group_s) {
+            /* lazy groups might have never been built */
             argx_group_free(argx->group_s);
         }
     }
+    arg_stream_source_free(&argx->source);
     array_free_ext(argx->sources, arg_stream_source_free);
+    array_free_ext(argx->pending, argx_pending_free);
+    array_free(argx->callback.after);
 }
 
-void v_argx_free(V_Argx *vargs) {
-    array_free(vargs);
+void argx_pending_free(Argx_Pending *pending) {
+    so_free(&pending->file);
+    arg_stream_source_free(&pending->source);
+}
+
+/* a scalar without a reference goes back to zero, as if it was never parsed */
+static void static_argx_clear(Argx *argx) {
+    if(!argx->val.any || argx->ref.any) return;
+    switch(argx->id) {
+        case ARGX_TYPE_INT: *argx->val.i = 0; break;
+        case ARGX_TYPE_SIZE: *argx->val.z = 0; break;
+        case ARGX_TYPE_DOUBLE: *argx->val.d = 0; break;
+        case ARGX_TYPE_FLOAT: *argx->val.f = 0; break;
+        case ARGX_TYPE_FLAG:
+        case ARGX_TYPE_BOOL: *argx->val.b = false; break;
+        case ARGX_TYPE_URI:
+        case ARGX_TYPE_STRING: *argx->val.so = SO; break;
+        case ARGX_TYPE_COLOR: *argx->val.c = (Color){0}; break;
+        case ARGX_TYPE_CUSTOM: memset(argx->val.any, 0, argx->custom.type->size); break;
+        case ARGX_TYPE_GROUP: {
+            /* of all groups only an enum and a flag mask have a value */
+            if(!argx->group_s) break;
+            if(argx->group_s->is_bitmask) *argx->val.mask = 0;
+            else if(argx->group_s->id == ARGX_GROUP_ENUM) *argx->val.i = 0;
+        } break;
+        default: break;
+    }
+}
+
+/* forget everything a parse left behind, keep what was registered */
+void argx_reset(Argx *argx) {
+    if(argx->attr.is_array) {
+        static_argx_unshare(argx);
+        switch(argx->id) {
+            case ARGX_TYPE_REST:
+            case ARGX_TYPE_URI:
+            case ARGX_TYPE_STRING: {
+                if(argx->attr.is_set) {
+                    if(argx->val.set) argx_so_set_free(argx->val.set);
+                } else if(argx->attr.is_map) {
+                    if(argx->val.map) argx_so_map_free(argx->val.map);
+                } else if(argx->val.vso) {
+                    array_free(*argx->val.vso);
+                }
+            } break;
+            case ARGX_TYPE_INT: {
+                if(argx->val.vi) array_free(*argx->val.vi);
+            } break;
+            case ARGX_TYPE_SIZE: {
+                if(argx->val.vz) array_free(*argx->val.vz);
+            } break;
+            case ARGX_TYPE_DOUBLE: {
+                if(argx->val.vd) array_free(*argx->val.vd);
+            } break;
+            case ARGX_TYPE_FLOAT: {
+                if(argx->val.vf) array_free(*argx->val.vf);
+            } break;
+            case ARGX_TYPE_BOOL: {
+                if(argx->attr.is_bitset) argx_bits_free(argx->val.bits);
+                else if(argx->val.vb) array_free(*argx->val.vb);
+            } break;
+            case ARGX_TYPE_COLOR: {
+                if(argx->val.vc) array_free(*argx->val.vc);
+            } break;
+            case ARGX_TYPE_CUSTOM: {
+                /* the container belongs to the caller, without a reset it keeps the earlier values */
+                if(argx->val.any && argx->custom.type->reset) argx->custom.type->reset(argx->val.any, argx->custom.user);
+            } break;
+            default: break;
+        }
+    } else {
+        if(argx->id == ARGX_TYPE_GROUP && argx->group_s) argx_group_reset(argx->group_s);
+        static_argx_clear(argx);
+    }
+    arg_stream_source_free(&argx->source);
+    argx->source = (Arg_Stream_Source){0};
+    array_free_ext(argx->sources, arg_stream_source_free);
+    array_free_ext(argx->pending, argx_pending_free);
+    arg_parse_setref_bind(argx);
 }
 
 struct Argx *argx_opt(struct Argx_Group *group, char cc, So name, So desc) {
     ASSERT_ARG(group);
-    ASSERT_ARG(group->table);
-    T_Argx_KV *kv = t_argx_once(group->table, name, (Argx){0});
-    if(!kv) {
-        Argx *e = t_argx_get(group->table, name);
+    ASSERT_ARG(group->arg);
+    Argx *result = 0;
+    Argx *e = 0;
+    /* subcommands may share option names among each other, but not with the other groups */
+    if(group->is_subcommand) e = arg_get_opt_shared(group->arg, name);
+    if(!e && group->table) {
+        T_Argx_KV *kv = t_argx_once(group->table, name, (Argx){0});
+        if(kv) result = &kv->val;
+        else e = t_argx_get(group->table, name);
+    } else if(!e) {
+        bool is_opt = (group->id == ARGX_GROUP_ROOT && !group->is_subcommand && group != &group->arg->pos && group != &group->arg->env);
+        e = is_opt ? arg_get_opt_shared(group->arg, name) : argx_group_get(group, name);
+        if(!e) result = arg_storage_argx(group->arg);
+    }
+    if(!result) {
         ASSERT_ARG(e->group_p);
         ABORT("trying to register an argument that already exists: '%.*s' in group: '%.*s'", SO_F(name), SO_F(e->group_p->name));
     }
-    kv->val.group_p = group;
+    result->group_p = group;
     unsigned char c = cc;
     if(c) {
         if(c <= '~' && c >= '!') {
             ASSERT_ARG(group->arg);
             size_t i = c - '!';
             Argx **dest = &group->arg->c[i];
-            if(!*dest) {
-                *dest = &kv->val;
+            if(group->is_subcommand) {
+                /* looked up in the selected subcommand, see arg_parse_get_shortopt */
+                if(*dest || argx_group_get_short(group, c)) {
+                    ABORT("trying to register an argument '%.*s' with duplicate short-opt: '%c'", SO_F(name), c);
+                }
+            } else if(!*dest) {
+                *dest = result;
             } else {
                 ABORT("trying to register an argument '%.*s' with duplicate short-opt: '%c'", SO_F(name), c);
             }
@@ -89,11 +220,11 @@ struct Argx *argx_opt(struct Argx_Group *group, char cc, So name, So desc) {
             ABORT("trying to register an argument '%.*s' with invalid short-opt: '%c' (= %#02x)", SO_F(name), c, c);
         }
     }
-    kv->val.c = c;
-    kv->val.opt = name;
-    kv->val.desc = desc;
-    array_push(group->list, &kv->val);
-    return &kv->val;
+    result->c = c;
+    result->opt = name;
+    result->desc = desc;
+    argx_group_push(group, result);
+    return result;
 }
 
 struct Argx *argx_pos(struct Arg *arg, So name, So desc) {
@@ -109,6 +240,12 @@ struct Argx *argx_env(struct Arg *arg, So name, So desc) {
 void argx_builtin_env_compgen(struct Arg *arg) {
     Argx *x = argx_env(arg, so("COMPGEN_WORDLIST"), so("generate input for autocompletion"));
     argx_type_bool(x, &arg->builtin.compgen, 0);
+    x = argx_env(arg, so("COMPGEN_WORD"), so("word to be completed"));
+    argx_type_so(x, &arg->builtin.compgen_word, 0);
+    x = argx_env(arg, so("COMPGEN_SCRIPT"), so("print a bash completion script"));
+    argx_type_bool(x, &arg->builtin.compgen_script, 0);
+    x = argx_env(arg, so("COMPGEN_CACHE"), so("file to cache completion candidates in"));
+    argx_type_so(x, &arg->builtin.compgen_cache, 0);
 }
 
 static Arg_Builtin_Color_List g_color_mode_default = ARG_BUILTIN_COLOR_AUTO;
@@ -139,15 +276,17 @@ int argx_callback_config(Argx *argx, void *user, So so) {
     return 0;
 }
 
+static void static_argx_builtin_populate_config(struct Argx_Group *g, void *user) {
+    Arg *arg = user;
+    for(Argx_Group *it = arg->opts; it; it = it->next) {
+        argx_flag(g, &it->config_print, 0, it->name, SO);
+    }
+}
+
 void argx_builtin_env_config(struct Arg *arg) {
     Argx *x = argx_env(arg, so("CONFIG_PRINT"), so("generate config of certain group"));
     argx_callback(x, argx_callback_config, arg, ARGX_PRIORITY_IMMEDIATELY);
-    Argx_Group *g = argx_group_flags(x);
-
-    Argx_Group **itE = array_itE(arg->opts);
-    for(Argx_Group **it = arg->opts; it < itE; ++it) {
-        argx_flag(g, &(*it)->config_print, 0, (*it)->name, SO);
-    }
+    argx_group_flags_lazy(x, static_argx_builtin_populate_config, arg);
 }
 
 int argx_callback_help(Argx *argx, void *user, So so) {
@@ -189,6 +328,7 @@ void argx_builtin_opt_version(struct Argx_Group *group, char c, So opt, So versi
     Argx *x = argx_opt(group, c, opt, so("print the version"));
     argx_callback(x, argx_callback_version, group->arg, ARGX_PRIORITY_IMMEDIATELY);
     group->arg->config.version = version;
+    group->arg->builtin.version_argx = x;
     argx_attr_configurable(x, false);
 }
 
@@ -209,11 +349,11 @@ void argx_builtin_opt_source(struct Argx_Group *group, char c, So opt, So uri) {
     }
     Argx *argx = arg->builtin.sources_argx;
     vso_push(argx->val.vso, uri);
+    vso_push(&arg->builtin.sources_default, uri);
 }
 
-void argx_builtin_opt_so_fx(struct Argx *x, So_Fx *fmt, So_Fx *ref) {
-    struct Argx_Group *g = 0;
-    g=argx_group_options(x);
+static void static_argx_builtin_populate_so_fx(struct Argx_Group *g, So_Fx *fmt, So_Fx *ref) {
+    Argx *x = 0;
       x=argx_opt(g, 0, so("fg"), so("foreground"));
         argx_type_color(x, &fmt->fg, ref ? &ref->fg : 0);
       x=argx_opt(g, 0, so("bg"), so("background"));
@@ -226,6 +366,19 @@ void argx_builtin_opt_so_fx(struct Argx *x, So_Fx *fmt, So_Fx *ref) {
         argx_type_bool(x, &fmt->underline, ref ? &ref->underline : 0);
 }
 
+static void static_argx_builtin_populate_so_fx_noref(struct Argx_Group *g, void *user) {
+    static_argx_builtin_populate_so_fx(g, user, 0);
+}
+
+void argx_builtin_opt_so_fx(struct Argx *x, So_Fx *fmt, So_Fx *ref) {
+    /* without reference the values already are the defaults, nothing to do until used */
+    if(!ref) {
+        argx_group_options_lazy(x, static_argx_builtin_populate_so_fx_noref, fmt);
+        return;
+    }
+    static_argx_builtin_populate_so_fx(argx_group_options(x), fmt, ref);
+}
+
 static void static_argx_builtin_set_rice(So_Fx *fx, bool *nocolor, Color *fg, Color *bg, bool bold, bool italic, bool underline) {
     fx->bold = bold;
     fx->italic = italic;
@@ -235,56 +388,61 @@ static void static_argx_builtin_set_rice(So_Fx *fx, bool *nocolor, Color *fg, Co
     fx->bg = bg ? *bg : (Color){0};
 }
 
+static void static_argx_builtin_populate_rice(struct Argx_Group *h, void *user) {
+    Arg *arg = user;
+    Argx *x = 0;
+      x=argx_opt(h, 0, so("program"), so("program name formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.program, 0);
+      x=argx_opt(h, 0, so("group"), so("group name formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.group, 0);
+      x=argx_opt(h, 0, so("group-delim"), so("group delimiter formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.group_delim, 0);
+      x=argx_opt(h, 0, so("pos"), so("positional formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.pos, 0);
+      x=argx_opt(h, 0, so("short"), so("short options formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.c, 0);
+      x=argx_opt(h, 0, so("long"), so("long options formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.opt, 0);
+      x=argx_opt(h, 0, so("env"), so("environment formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.env, 0);
+      x=argx_opt(h, 0, so("desc"), so("description formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.desc, 0);
+      x=argx_opt(h, 0, so("subopt"), so("suboption formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.subopt, 0);
+      x=argx_opt(h, 0, so("subopt-delim"), so("suboption delimiter formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.subopt_delim, 0);
+      x=argx_opt(h, 0, so("enum"), so("enum formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.enum_unset, 0);
+      x=argx_opt(h, 0, so("enum-set"), so("enum set formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.enum_set, 0);
+      x=argx_opt(h, 0, so("enum-delim"), so("enum delimiter formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.enum_delim, 0);
+      x=argx_opt(h, 0, so("flag"), so("flag formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.flag_unset, 0);
+      x=argx_opt(h, 0, so("flag-set"), so("flag set formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.flag_set, 0);
+      x=argx_opt(h, 0, so("flag-delim"), so("flag delimiter formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.flag_delim, 0);
+      x=argx_opt(h, 0, so("hint"), so("hint formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.hint, 0);
+      x=argx_opt(h, 0, so("hint-delim"), so("hint delimiter formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.hint_delim, 0);
+      x=argx_opt(h, 0, so("val"), so("value formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.val, 0);
+      x=argx_opt(h, 0, so("val-delim"), so("value formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.val_delim, 0);
+      x=argx_opt(h, 0, so("switch"), so("switch formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.sw, 0);
+      x=argx_opt(h, 0, so("switch-delim"), so("switch formatting"));
+        argx_builtin_opt_so_fx(x, &arg->rice.sw_delim, 0);
+}
+
 struct Argx_Group *argx_builtin_rice(struct Arg *arg) {
-    struct Argx_Group *g = 0, *h = 0;
+    struct Argx_Group *g = 0;
     Argx *x = 0;
     g=argx_group(arg, so("rice"));
       x=argx_opt(g, 0, so("arg"), so("look & feel of the argument parser"));
-        h=argx_group_options(x);
-          x=argx_opt(h, 0, so("program"), so("program name formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.program, 0);
-          x=argx_opt(h, 0, so("group"), so("group name formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.group, 0);
-          x=argx_opt(h, 0, so("group-delim"), so("group delimiter formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.group_delim, 0);
-          x=argx_opt(h, 0, so("pos"), so("positional formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.pos, 0);
-          x=argx_opt(h, 0, so("short"), so("short options formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.c, 0);
-          x=argx_opt(h, 0, so("long"), so("long options formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.opt, 0);
-          x=argx_opt(h, 0, so("env"), so("environment formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.env, 0);
-          x=argx_opt(h, 0, so("desc"), so("description formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.desc, 0);
-          x=argx_opt(h, 0, so("subopt"), so("suboption formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.subopt, 0);
-          x=argx_opt(h, 0, so("subopt-delim"), so("suboption delimiter formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.subopt_delim, 0);
-          x=argx_opt(h, 0, so("enum"), so("enum formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.enum_unset, 0);
-          x=argx_opt(h, 0, so("enum-set"), so("enum set formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.enum_set, 0);
-          x=argx_opt(h, 0, so("enum-delim"), so("enum delimiter formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.enum_delim, 0);
-          x=argx_opt(h, 0, so("flag"), so("flag formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.flag_unset, 0);
-          x=argx_opt(h, 0, so("flag-set"), so("flag set formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.flag_set, 0);
-          x=argx_opt(h, 0, so("flag-delim"), so("flag delimiter formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.flag_delim, 0);
-          x=argx_opt(h, 0, so("hint"), so("hint formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.hint, 0);
-          x=argx_opt(h, 0, so("hint-delim"), so("hint delimiter formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.hint_delim, 0);
-          x=argx_opt(h, 0, so("val"), so("value formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.val, 0);
-          x=argx_opt(h, 0, so("val-delim"), so("value formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.val_delim, 0);
-          x=argx_opt(h, 0, so("switch"), so("switch formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.sw, 0);
-          x=argx_opt(h, 0, so("switch-delim"), so("switch formatting"));
-            argx_builtin_opt_so_fx(x, &arg->rice.sw_delim, 0);
+        argx_group_options_lazy(x, static_argx_builtin_populate_rice, arg);
 
     bool *nofx = &arg->builtin.color_off;
     static_argx_builtin_set_rice(&arg->rice.program,        nofx, &COLOR_RGB(0xdd, 0x55, 0x55), 0, true, false, false);
@@ -330,10 +488,10 @@ void argx_fmt_help(So *out, Argx *argx, bool full_help) {
     //argx_so(&xso, argx, &opts);
 
     ASSERT_ARG(argx->group_p);
-    bool treat_as_options = (argx->group_p->table == &argx->group_p->arg->t_opt);
     bool treat_short_spacing = (
             argx->group_p == &argx->group_p->arg->env
          || argx->group_p == &argx->group_p->arg->pos);
+    bool treat_as_options = (argx->group_p->id == ARGX_GROUP_ROOT && !treat_short_spacing);
 
 #if 0
     /* aligning... gather lengths and spacing (( +1 because of spaces between things )) */
@@ -402,8 +560,9 @@ void argx_fmt_config(So *out, Arg_Rice *rice, Argx *argx) {
     /* hack the matrix to influence output of flags and enum */
     bool do_value = false;
     if(argx->id == ARGX_TYPE_GROUP) {
-        if(argx->group_s) {
-            switch(argx->group_s->id) {
+        Argx_Group *sub = argx_group_sub(argx);
+        if(sub) {
+            switch(sub->id) {
                 case ARGX_GROUP_FLAGS: do_value = true; break;
                 case ARGX_GROUP_ENUM: do_value = true; break;
                 default: break;
@@ -429,9 +588,8 @@ void argx_fmt_config(So *out, Arg_Rice *rice, Argx *argx) {
 
     if(argx->id == ARGX_TYPE_GROUP) {
         if(argx->group_p) {
-            Argx **itE = array_itE(argx->group_s->list);
-            for(Argx **it = argx->group_s->list; it < itE; ++it) {
-                argx_fmt_config(out, rice, *it);
+            for(Argx *it = argx_group_sub(argx)->list; it; it = it->next) {
+                argx_fmt_config(out, rice, it);
             }
         }
     }
@@ -460,6 +618,38 @@ void argx_fmt_config(So *out, Arg_Rice *rice, Argx *argx) {
     //////}
 }
 
+bool argx_is_set(Argx *argx) {
+    ASSERT_ARG(argx);
+    if(argx->pending) return true;
+    if(argx->attr.is_array) return (bool)argx->sources;
+    return (argx->source.id != ARG_STREAM_SOURCE_NONE);
+}
+
+/* set by anything but its reference */
+bool argx_is_explicit(Argx *argx) {
+    ASSERT_ARG(argx);
+    if(argx->pending) return true;
+    if(argx->attr.is_array) {
+        Arg_Stream_Source *itE = array_itE(argx->sources);
+        for(Arg_Stream_Source *it = argx->sources; it < itE; ++it) {
+            if(it->id != ARG_STREAM_SOURCE_REFVAL) return true;
+        }
+        return false;
+    }
+    return (argx->source.id != ARG_STREAM_SOURCE_NONE && argx->source.id != ARG_STREAM_SOURCE_REFVAL);
+}
+
+/* flags of argx_group_flags_mask don't have a bool of their own */
+bool argx_flag_is_set(Argx *flag) {
+    ASSERT_ARG(flag);
+    Argx_Group *group = flag->group_p;
+    if(group && group->is_bitmask) {
+        uint64_t *mask = group->parent->val.mask;
+        return mask && ((*mask >> flag->attr.val_enum) & 1);
+    }
+    return flag->val.b && *flag->val.b;
+}
+
 bool argx_is_configurable(Argx *argx) {
     if(!argx) return false;
     if(argx->attr.is_unconfigurable) return false;
@@ -7,13 +7,12 @@
 #include "argx-so.h"
 #include "argx-attr.h"
 #include "argx-callback.h"
+#include "arg-stream.h"
 
 #define ARGX_SHORT_MIN      ('!')
 #define ARGX_SHORT_MAX      ('~' + 1)
 #define ARGX_SHORT_COUNT    (ARGX_SHORT_MAX - ARGX_SHORT_MIN)
 
-typedef struct Arg_Stream_Source Arg_Stream_Source;
-
 typedef enum {
     ARGX_TYPE_NONE,
     ARGX_TYPE_REST,
@@ -27,6 +26,9 @@ typedef enum {
     ARGX_TYPE_FLAG,
     ARGX_TYPE_COLOR,
     ARGX_TYPE_SWITCH,
+    ARGX_TYPE_CUSTOM,
+    ARGX_TYPE_DOUBLE,
+    ARGX_TYPE_FLOAT,
     /* keep above */
     ARGX_TYPE__COUNT,
 } Argx_Type_List;
@@ -37,12 +39,22 @@ typedef union Argx_Value_Union {
     int **vi;
     ssize_t *z;
     ssize_t **vz;
+    double *d;
+    double **vd;
+    float *f;
+    float **vf;
     bool *b;
     bool **vb;
     So *so;
     VSo *vso;
     Color *c;
     Color **vc;
+    uint64_t *mask;
+    Argx_Bits *bits;
+    Argx_Range **vr;
+    Argx_So_Set **set;
+    Argx_So_Map **map;
+    struct Argx_So_Map_Item *kv;
     struct Argx_Switch *sw;
 } Argx_Value_Union;
 
@@ -65,31 +77,78 @@ typedef struct Argx_Switch {
     Argx_Value_Union val;
 } Argx_Switch;
 
+typedef struct Argx_Pending {
+    So so;                      /* raw value, converted by argx_resolve */
+    So file;                    /* or read the values from here first, see file("...") */
+    Arg_Stream_Source source;
+    bool is_config;
+} Argx_Pending;
+
 typedef struct Argx {
     Argx_Value_Union val;  /* parsed value */
     Argx_Value_Union ref;  /* reference / default value (refval) */
     Argx_Hint hint;
     Argx_Type_List id;
-    Arg_Stream_Source *sources;  /* from where the value gets set -- should be an array if is_array, else, a single value. optional with a line number (some.config:123) */
+    Arg_Stream_Source source;    /* from where the value gets set, if not is_array. optional with a line number (some.config:123) */
+    Arg_Stream_Source *sources;  /* from where each value gets set, if is_array */
+    Argx_Pending *pending;       /* not yet converted values, see argx_attr_lazy */
     struct Argx_Group *group_p; /* always set to parent group */
-    struct Argx_Group *group_s; /* only set if id == ARGX_GROUP */
+    struct Argx_Group *group_s; /* only set if id == ARGX_GROUP, see argx_group_sub */
+    struct {
+        Argx_Group_Populate populate;   /* builds group_s on first use */
+        void *user;
+        int id;                         /* Argx_Group_List of group_s */
+    } lazy;
+    struct {
+        const Argx_Type *type;          /* only set if id == ARGX_TYPE_CUSTOM */
+        void *user;
+    } custom;
+    struct Argx *next;          /* next argx within group_p */
+    struct Argx *required_next; /* next in arg->required */
     Argx_Callback callback;
     Argx_Attr attr;
     So desc;
     So opt;
     char c;
-} Argx, *V_Argx;
+} Argx;
 
 LUT_INCLUDE(T_Argx, t_argx, So, BY_VAL, Argx, BY_VAL)
-
-void v_argx_free(V_Argx *vargs);
+LUT_INCLUDE(T_So_Set, t_so_set, So, BY_VAL, size_t, BY_VAL)
+
+struct Argx_So_Set {
+    VSo list;           /* in order of insertion */
+    T_So_Set table;     /* string -> index into list */
+};
+
+typedef struct Argx_So_Map_Item {
+    So key;
+    So val;
+    Arg_Stream_Source source;   /* where the key got its value */
+} Argx_So_Map_Item;
+
+struct Argx_So_Map {
+    Argx_So_Map_Item *list;     /* in order of first insertion */
+    T_So_Set table;             /* key -> index into list */
+};
+
+void argx_free(Argx *argx);
+void argx_reset(Argx *argx);
+void argx_pending_free(Argx_Pending *pending);
+void argx_bits_extend(Argx_Bits *bits, Argx_Bits *other);
+void argx_range_merge(Argx_Range **ranges, Argx_Range *other);
+void argx_so_set_extend(Argx_So_Set **set, Argx_So_Set *other);
+Argx_So_Map_Item *argx_so_map_item(Argx_So_Map *map, So key);
+void argx_so_map_put(Argx_So_Map **map, So key, So val, Arg_Stream_Source src);
+void argx_so_map_extend(Argx_So_Map **map, Argx_So_Map *other);
 
 void argx_fmt_help(So *out, Argx *argx, bool full_help);
 void argx_fmt_config(So *out, Arg_Rice *rice, Argx *argx);
 
 void arg_update_color_off(struct Arg *arg); // TODO: move this somewhere else (also source)
 
-//bool argx_is_any_source_
+bool argx_is_set(Argx *argx);
+bool argx_is_explicit(Argx *argx);
+bool argx_flag_is_set(Argx *flag);
 bool argx_is_configurable(Argx *argx);
 bool argx_is_subgroup_of_root(Argx *argx, struct Argx_Group *group);
 //bool argx_is_multiline_config(Argx *argx);
@@ -0,0 +1,101 @@
+#include "../rlarg.h"
+#include <rlc.h>
+#include <time.h>
+
+/* validates command lines in-process. without arguments it checks a few lines,
+ * otherwise it acts as a bench:  batch <file, one command line per line> [repeat] */
+
+typedef struct Tool {
+    int jobs;
+    bool verbose;
+    So output;
+    VSo files;
+    size_t n_written;
+} Tool;
+
+/* only validates, batch calls it too */
+int check_jobs(struct Argx *argx, void *user, So so) {
+    Tool *tool = user;
+    return tool->jobs > 64 ? -1 : 0;
+}
+
+/* a side effect, batch never calls it */
+int write_output(struct Argx *argx, void *user, So so) {
+    Tool *tool = user;
+    ++tool->n_written;
+    return 0;
+}
+
+typedef struct Report {
+    size_t n_lines;
+    Arg_Parse_Error_List errors[8];
+    bool print;
+} Report;
+
+void report(struct Arg *arg, size_t line, So cmd, int status, Arg_Parse_Error_List error, void *user) {
+    Report *r = user;
+    if(r->n_lines < sizeof(r->errors) / sizeof(*r->errors)) r->errors[r->n_lines] = error;
+    ++r->n_lines;
+    if(r->print && status) printf("%zu: error %u: %.*s\n", line, error, SO_F(cmd));
+}
+
+int main(int argc, const char **argv) {
+    Tool tool = {0};
+
+    struct Arg *arg = arg_new(0);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+    struct Argx *x;
+    argx_builtin_opt_help(g, ARGX_BUILTIN_OPT_HELP);
+    argx_builtin_opt_version(g, ARGX_BUILTIN_OPT_VERSION, so("1.0"));
+    x=argx_pos(arg, so("files"), so("files to process"));
+      argx_type_rest(x, &tool.files);
+    x=argx_opt(g, 'j', so("jobs"), so("number of jobs"));
+      argx_type_int(x, &tool.jobs, &(int){ 1 });
+      argx_callback(x, check_jobs, &tool, ARGX_PRIORITY_WHEN_ALL_VALID);
+      argx_attr_callback_batch(x, true);
+    x=argx_opt(g, 'v', so("verbose"), so("be verbose"));
+      argx_type_bool(x, &tool.verbose, &(bool){ false });
+    x=argx_opt(g, 'o', so("output"), so("output file"));
+      argx_type_so(x, &tool.output, &so("out"));
+      argx_callback(x, write_output, &tool, ARGX_PRIORITY_WHEN_ALL_VALID);
+
+    Report r = {0};
+    if(argc < 2) {
+        So input = so("tool -j 4 a b\n"
+                      "\n"
+                      "tool --jobs=x\n"
+                      "tool -o 'with space' --version\n"
+                      "tool --nope\n"
+                      "tool -j 100\n"
+                      "tool -o 'open\n");
+        int failed = arg_parse_batch(arg, input, '\n', report, &r);
+        ASSERT(failed == 4, "expect four lines to fail, got %i", failed);
+        ASSERT(r.n_lines == 6, "expect empty lines to be skipped");
+        ASSERT(r.errors[0] == ARG_PARSE_ERROR_NONE, "expect first line to pass");
+        ASSERT(r.errors[1] == ARG_PARSE_ERROR_INVALID_CONVERSION, "expect conversion error");
+        ASSERT(r.errors[2] == ARG_PARSE_ERROR_NONE, "expect quotes and --version to pass");
+        ASSERT(r.errors[3] == ARG_PARSE_ERROR_INVALID_OPTION_ROOT, "expect unknown option error");
+        ASSERT(r.errors[5] == ARG_PARSE_ERROR_MISSING_STRING_DELIM, "expect an unterminated quote to fail");
+        ASSERT(!tool.n_written, "expect callbacks with side effects to be skipped");
+    } else {
+        So input = SO;
+        if(so_file_read(so_l(argv[1]), &input)) {
+            ABORT("could not read: %s", argv[1]);
+        }
+        int repeat = argc > 2 ? atoi(argv[2]) : 1;
+        int failed = 0;
+        r.print = (repeat == 1);
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for(int i = 0; i < repeat; ++i) {
+            failed += arg_parse_batch(arg, input, '\n', report, &r);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double s = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+        printf("%zu lines, %i failed, %.3f s, %.0f lines/s\n", r.n_lines, failed, s, (double)r.n_lines / s);
+        so_free(&input);
+    }
+
+    arg_free(&arg);
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include "../rlarg.h"
+#include <rlc.h>
+
+int main(void) {
+    Argx_Bits features = {0};
+    Argx_Bits features_ref = {0};
+    argx_bits_push(&features_ref, true);
+
+    struct Arg_Config *cfg = arg_config_new();
+    struct Arg *arg = arg_new(cfg);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+
+    struct Argx *x = argx_opt(g, 'f', so("features"), so("feature mask"));
+      argx_type_array_bits(x, &features, &features_ref);
+
+    ASSERT(features.len == 1 && argx_bits_get(&features, 0), "expect the default");
+
+    arg_parse_config(arg, so("[default]\nfeatures = [\n  true,\n  false,\n  true\n]\n"), so("bits.conf"));
+    ASSERT(features.len == 3, "expect the config to replace the default");
+
+    const char *argv[] = { "test", "-f", "0b01", "--features", "0xf0", "-f", "[false,true]" };
+    const int argc = sizeof(argv) / sizeof(*argv);
+    bool quit_early = false;
+    int result = arg_parse(arg, argc, argv, &quit_early);
+
+    ASSERT(!result, "expect a valid parse");
+    ASSERT(features.len == 3 + 2 + 8 + 2, "expect every value to be appended");
+    bool expect[] = { 1,0,1, 0,1, 1,1,1,1,0,0,0,0, 0,1 };
+    for(size_t i = 0; i < sizeof(expect) / sizeof(*expect); ++i) {
+        ASSERT(argx_bits_get(&features, i) == expect[i], "expect bit %zu to be %u", i, expect[i]);
+    }
+
+    arg_free(&arg);
+    arg_config_free(&cfg);
+    return 0;
+}
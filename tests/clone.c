@@ -0,0 +1,120 @@
+#include "../rlarg.h"
+#include <rlc.h>
+#include <pthread.h>
+#include <stdio.h>
+
+typedef struct Job {
+    int level;
+    bool verbose;
+    VSo files;
+    bool fa, fb;
+    int delay;
+    size_t n_delay;
+} Job;
+
+/* counts the conversions in user, which lives in the job as well */
+static int delay_convert(void *val, So so, void *user) {
+    ++*(size_t *)user;
+    return so_as_int(so, val, 0);
+}
+
+#define N_THREADS   8
+#define N_PARSES    300
+
+typedef struct Worker {
+    struct Arg *arg;    /* shared, every worker clones it */
+    Job *template;
+    int id;
+    size_t n_valid;
+} Worker;
+
+static void *worker(void *user) {
+    Worker *w = user;
+    Job job = {0};
+    struct Arg *clone = arg_clone(w->arg);
+    arg_rebind(clone, w->template, &job, sizeof(job));
+    for(int i = 0; i < N_PARSES; ++i) {
+        char level[32], delay[32];
+        snprintf(level, sizeof(level), "%i", w->id * 1000 + i);
+        snprintf(delay, sizeof(delay), "%i", i);
+        const char *argv[] = { "clone", "-l", level, "--delay", delay, i % 2 ? "--all" : "-v", "file" };
+        arg_reset(clone);
+        bool quit_early = false;
+        if(arg_parse(clone, sizeof(argv) / sizeof(*argv), argv, &quit_early)) continue;
+        if(job.level != w->id * 1000 + i || job.delay != i || job.n_delay != (size_t)i + 1) continue;
+        if(job.verbose == (i % 2) || job.fa != (i % 2) || array_len(job.files) != 1) continue;
+        ++w->n_valid;
+    }
+    arg_free(&clone);
+    return 0;
+}
+
+int main(void) {
+    Job template = {0};
+    Argx_Type delay = {
+        .hint = so("ms"),
+        .size = sizeof(int),
+        .convert = delay_convert,
+    };
+
+    struct Arg *arg = arg_new(0);
+    struct Argx_Group *g = argx_group(arg, so("default")), *h;
+    struct Argx *x, *xs;
+    argx_builtin_opt_help(g, ARGX_BUILTIN_OPT_HELP);
+    x=argx_pos(arg, so("files"), so("files to process"));
+      argx_type_rest(x, &template.files);
+    x=argx_opt(g, 'l', so("level"), so("a level"));
+      argx_type_int(x, &template.level, &(int){ 1 });
+    x=argx_opt(g, 'v', so("verbose"), so("be verbose"));
+      argx_type_bool(x, &template.verbose, &(bool){ false });
+    x=argx_opt(g, 0, so("delay"), so("a custom type"));
+      argx_type_custom(x, &delay, &template.n_delay, &template.delay, 0);
+    xs=argx_opt(g, 0, so("all"), so("set all flags"));
+      argx_type_switch(xs);
+    x=argx_opt(g, 0, so("flags"), so("some flags"));
+      h=argx_group_flags(x);
+      x=argx_flag(h, &template.fa, &(bool){ false }, so("a"), so("flag a"));
+        argx_switch_flag(xs, x, true);
+      x=argx_flag(h, &template.fb, &(bool){ false }, so("b"), so("flag b"));
+        argx_switch_flag(xs, x, true);
+
+    /* two independent parsers, each writing into its own job */
+    Job j1 = {0}, j2 = {0};
+    struct Arg *a1 = arg_clone(arg);
+    struct Arg *a2 = arg_clone(arg);
+    arg_rebind(a1, &template, &j1, sizeof(template));
+    arg_rebind(a2, &template, &j2, sizeof(template));
+
+    const char *argv1[] = { "clone", "-l", "5", "--all", "--delay", "7", "x", "y" };
+    const char *argv2[] = { "clone", "-v", "--flags", "b", "z" };
+    bool quit_early = false;
+    int result = arg_parse(a1, sizeof(argv1) / sizeof(*argv1), argv1, &quit_early);
+    ASSERT(!result, "expect first parse to succeed");
+    result = arg_parse(a2, sizeof(argv2) / sizeof(*argv2), argv2, &quit_early);
+    ASSERT(!result, "expect second parse to succeed");
+
+    ASSERT(j1.level == 5 && !j1.verbose && j1.fa && j1.fb, "expect first job to be parsed");
+    ASSERT(array_len(j1.files) == 2, "expect first job to have two files");
+    ASSERT(j1.delay == 7 && j1.n_delay == 1, "expect the custom type to get the user data of the first job");
+    ASSERT(j2.level == 1 && j2.verbose && !j2.fa && j2.fb, "expect second job to be parsed");
+    ASSERT(array_len(j2.files) == 1, "expect second job to have one file");
+    ASSERT(template.level == 1 && !template.files && !template.n_delay, "expect the original to only hold its defaults");
+
+    /* many threads, each with its own clone, parsing over and over */
+    pthread_t threads[N_THREADS];
+    Worker workers[N_THREADS] = {0};
+    for(int i = 0; i < N_THREADS; ++i) {
+        workers[i] = (Worker){ .arg = arg, .template = &template, .id = i };
+        ASSERT(!pthread_create(&threads[i], 0, worker, &workers[i]), "expect to start a thread");
+    }
+    for(int i = 0; i < N_THREADS; ++i) {
+        pthread_join(threads[i], 0);
+        ASSERT(workers[i].n_valid == N_PARSES, "expect every parse of thread %i to be valid, got %zu", i, workers[i].n_valid);
+    }
+    ASSERT(template.level == 1 && !template.n_delay, "expect the original to be untouched by the threads");
+
+    arg_free(&a1);
+    arg_free(&a2);
+    arg_free(&arg);
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "../rlarg.h"
+#include <rlc.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef enum {
+    MODE_FAST,
+    MODE_SLOW,
+} Mode;
+
+typedef struct Paths {
+    char dir[64];
+    char conf[96];
+    char cache[96];
+    char out[96];
+} Paths;
+
+static void write_file(const char *path, So content) {
+    FILE *file = fopen(path, "wb");
+    ASSERT(file, "expect to write %s", path);
+    fwrite(content.str, 1, so_len(content), file);
+    fclose(file);
+}
+
+/* a fresh parser for every completion, like a tab press */
+static void complete(Paths *paths, const char *word) {
+    Mode mode = MODE_FAST;
+    int jobs = 0;
+    bool verbose = false;
+
+    struct Arg *arg = arg_new(0);
+    argx_builtin_env_compgen(arg);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+    argx_builtin_opt_help(g, ARGX_BUILTIN_OPT_HELP);
+    argx_builtin_opt_source(g, ARGX_BUILTIN_OPT_SOURCE, so_l(paths->conf));
+    struct Argx *x = argx_opt(g, 'm', so("mode"), so("how to run"));
+      struct Argx_Group *g2 = argx_group_enum(x, (int *)&mode, 0);
+        argx_enum_bind(g2, MODE_FAST, so("fast"), so("run fast"));
+        argx_enum_bind(g2, MODE_SLOW, so("slow"), so("run slow"));
+    x = argx_opt(g, 'j', so("jobs"), so("number of jobs"));
+      argx_type_int(x, &jobs, 0);
+    x = argx_opt(g, 'v', so("verbose"), so("be verbose"));
+      argx_type_bool(x, &verbose, 0);
+
+    const char *argv[] = { "tool", word };
+    bool quit_early = false;
+    arg_parse(arg, 2, argv, &quit_early);
+    arg_free(&arg);
+}
+
+/* what one completion prints, either by the parser or from the cache */
+static bool reply(Paths *paths, So *out, const char *word, bool cached) {
+    setenv("COMPGEN_WORD", word, 1);
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int fd = open(paths->out, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    dup2(fd, STDOUT_FILENO);
+    close(fd);
+    const char *argv[] = { "tool", word };
+    bool valid = true;
+    if(cached) valid = arg_compgen_cached(2, argv);
+    else complete(paths, word);
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    so_clear(out);
+    so_file_read(so_l(paths->out), out);
+    return valid;
+}
+
+int main(void) {
+    Paths paths = {0};
+    snprintf(paths.dir, sizeof(paths.dir), "/tmp/rlarg-compgen-XXXXXX");
+    ASSERT(mkdtemp(paths.dir), "expect a temporary directory");
+    snprintf(paths.conf, sizeof(paths.conf), "%s/tool.conf", paths.dir);
+    snprintf(paths.cache, sizeof(paths.cache), "%s/cache", paths.dir);
+    snprintf(paths.out, sizeof(paths.out), "%s/out", paths.dir);
+    write_file(paths.conf, so("[default]\njobs = 2\n"));
+
+    setenv("COMPGEN_WORDLIST", "true", 1);
+    setenv("COMPGEN_CACHE", paths.cache, 1);
+
+    So uncached = SO, cached = SO, file = SO;
+    ASSERT(!reply(&paths, &cached, "--", true), "expect no cache before the first completion");
+
+    /* the first completion writes the cache, it answers the same from then on */
+    const char *words[] = { "--", "--mode=", "--j", "-" };
+    for(size_t i = 0; i < sizeof(words) / sizeof(*words); ++i) {
+        reply(&paths, &uncached, words[i], false);
+        ASSERT(reply(&paths, &cached, words[i], true), "expect a valid cache for '%s'", words[i]);
+        ASSERT(so_len(uncached), "expect candidates for '%s'", words[i]);
+        ASSERT(!so_cmp(uncached, cached), "expect the cache to reply the same for '%s': '%.*s' vs '%.*s'", words[i], SO_F(uncached), SO_F(cached));
+    }
+
+    /* a touched source invalidates it, the next completion rebuilds it */
+    struct timespec times[2] = { { .tv_nsec = UTIME_OMIT }, { .tv_sec = 1000000000 } };
+    ASSERT(!utimensat(AT_FDCWD, paths.conf, times, 0), "expect to touch the source");
+    ASSERT(!reply(&paths, &cached, "--", true), "expect a touched source to invalidate the cache");
+    reply(&paths, &uncached, "--", false);
+    ASSERT(reply(&paths, &cached, "--", true), "expect the cache to be rebuilt");
+    ASSERT(!so_cmp(uncached, cached), "expect the rebuilt cache to reply the same");
+
+    /* as if the executable got replaced: its stat line is the first one after the magic */
+    ASSERT(!so_file_read(so_l(paths.cache), &file), "expect to read the cache");
+    size_t i = so_find_ch(file, '\n') + 1;
+    ASSERT(i < so_len(file), "expect a stat line of the executable");
+    file.str[i] = file.str[i] == '1' ? '2' : '1';
+    write_file(paths.cache, file);
+    ASSERT(!reply(&paths, &cached, "--", true), "expect a changed executable to invalidate the cache");
+
+    remove(paths.out);
+    remove(paths.cache);
+    remove(paths.conf);
+    rmdir(paths.dir);
+    so_free(&uncached);
+    so_free(&cached);
+    so_free(&file);
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "../rlarg.h"
+#include <rlc.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+typedef enum {
+    MODE_FAST,
+    MODE_SLOW,
+} Mode;
+
+typedef struct Tool {
+    Mode mode;
+    int style;
+    So name;
+    bool xtra;
+} Tool;
+
+static struct Arg *tool_arg(Tool *tool) {
+    struct Arg *arg = arg_new(0);
+    argx_builtin_env_compgen(arg);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+    argx_builtin_opt_help(g, ARGX_BUILTIN_OPT_HELP);
+    struct Argx *x = argx_opt(g, 'n', so("name"), so("a name"));
+      argx_type_so(x, &tool->name, 0);
+    x = argx_opt(g, 'm', so("mode"), so("how to run"));
+      struct Argx_Group *g2 = argx_group_enum(x, (int *)&tool->mode, 0);
+        argx_enum_bind(g2, MODE_FAST, so("fast"), so("run fast"));
+        argx_enum_bind(g2, MODE_SLOW, so("slow"), so("run slow"));
+    x = argx_opt(g, 'x', so("xtra"), so("extra"));
+      argx_type_bool(x, &tool->xtra, 0);
+    x = argx_opt(g, 's', so("style"), so("values that need quoting"));
+      g2 = argx_group_enum(x, &tool->style, 0);
+        argx_enum_bind(g2, 0, so("with space"), so("a space"));
+        argx_enum_bind(g2, 1, so("it's"), so("a quote"));
+    return arg;
+}
+
+/* what one tab press prints, argv as the completion script builds it */
+static So reply(const char *path, So *out, const char *word, int argc, const char **argv) {
+    Tool tool = {0};
+
+    setenv("COMPGEN_WORD", word, 1);
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    dup2(fd, STDOUT_FILENO);
+    close(fd);
+
+    struct Arg *arg = tool_arg(&tool);
+    bool quit_early = false;
+    arg_parse(arg, argc, argv, &quit_early);
+    arg_free(&arg);
+
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    so_clear(out);
+    so_file_read(so_l(path), out);
+    so_free(&tool.name);
+    /* the reply starts after the last newline */
+    size_t i0 = 0;
+    for(size_t i = 0; i < so_len(*out); ++i) {
+        if(so_at(*out, i) == '\n') i0 = i + 1;
+    }
+    return so_i0(*out, i0);
+}
+
+static bool has(So out, const char *part) {
+    So p = so_l(part);
+    for(size_t i = 0; i + so_len(p) <= so_len(out); ++i) {
+        if(!so_cmp(so_sub(out, i, i + so_len(p)), p)) return true;
+    }
+    return false;
+}
+
+#define EXPECT(path, out, expect, word, ...) do { \
+        const char *argv[] = { "tool", __VA_ARGS__ }; \
+        So got = reply(path, out, word, sizeof(argv) / sizeof(*argv), argv); \
+        So want = so_ll(expect, sizeof(expect) - 1); \
+        ASSERT(!so_cmp(got, want), "expect the reply for '%s' to be '%.*s', got '%.*s'", word, SO_F(want), SO_F(got)); \
+    } while(0)
+
+int main(void) {
+    char dir[64] = "/tmp/rlarg-compgen-XXXXXX";
+    char path[96];
+    ASSERT(mkdtemp(dir), "expect a temporary directory");
+    snprintf(path, sizeof(path), "%s/out", dir);
+    setenv("COMPGEN_WORDLIST", "true", 1);
+
+    So out = SO;
+    /* only the candidates starting with the word */
+    EXPECT(path, &out, "--help\0--name\0--mode\0--xtra\0--style\0", "--", "--");
+    EXPECT(path, &out, "--xtra\0", "--x", "--x");
+    EXPECT(path, &out, "--xtra\0", "--x", "--name", "a b", "--x");
+    /* --option=<tab> prints only the values of that option */
+    EXPECT(path, &out, "fast\0slow\0", "--mode=", "--mode=");
+    EXPECT(path, &out, "slow\0", "--mode=s", "--mode=s");
+    /* a value in the next word */
+    EXPECT(path, &out, "fast\0slow\0", "", "-m");
+    EXPECT(path, &out, "fast\0", "f", "-m", "f");
+    EXPECT(path, &out, "", "--q", "--q");
+    /* quoted as bash would, so the script reads the reply as it is */
+    EXPECT(path, &out, "with\\ space\0it\\'s\0", "--style=", "--style=");
+    EXPECT(path, &out, "it\\'s\0", "i", "-s", "i");
+
+    /* the standalone script knows the same without running the program */
+    Tool tool = {0};
+    struct Arg *arg = tool_arg(&tool);
+    so_clear(&out);
+    arg_compgen_script(arg, &out, so("/usr/bin/tool"));
+    arg_free(&arg);
+    ASSERT(has(out, "_complete_tool() {"), "expect the completion function");
+    ASSERT(has(out, "complete -o bashdefault -o default -F _complete_tool tool"), "expect it to be registered for the program");
+    ASSERT(has(out, "words=( '--help' '-h' '--name' '-n' '--mode' '-m' '--xtra' '-x' '--style' '-s' )"), "expect the options");
+    ASSERT(has(out, "'--name'|'-n'|'--mode'|'-m'|'--style'|'-s') takes=1"), "expect the options taking a value");
+    ASSERT(has(out, "'--mode'|'-m'|'--mode='|'-m=') words=( 'fast' 'slow')"), "expect the values of the enum");
+    ASSERT(has(out, "'--xtra='|'-x=') words=( 'true' 'false')"), "expect the values of the flag");
+    ASSERT(has(out, "words=( 'with space' 'it'\\''s')"), "expect values quoted for bash");
+    ASSERT(has(out, "'default.' 'default.help' 'default.name' 'default.mode.' 'default.mode.fast'"), "expect the help hierarchy");
+
+    remove(path);
+    rmdir(dir);
+    so_free(&out);
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include "../rlarg.h"
+#include <rlc.h>
+
+/* milliseconds from 250ms, 3s or 2m */
+static int duration_convert(void *val, So so, void *user) {
+    ssize_t n = 0;
+    size_t i = 0;
+    while(i < so_len(so) && so_at(so, i) >= '0' && so_at(so, i) <= '9') ++i;
+    if(!i || so_as_ssize(so_iE(so, i), &n, 0)) return -1;
+    So unit = so_i0(so, i);
+    if(!so_cmp(unit, so("ms"))) *(ssize_t *)val = n;
+    else if(!so_cmp(unit, so("s"))) *(ssize_t *)val = n * 1000;
+    else if(!so_cmp(unit, so("m"))) *(ssize_t *)val = n * 60000;
+    else return -1;
+    return 0;
+}
+
+static void duration_fmt(So *out, void *val, void *user) {
+    so_fmt(out, "%zims", *(ssize_t *)val);
+}
+
+static void duration_compgen(VSo *candidates, void *user) {
+    array_push(*candidates, so("1s"));
+    array_push(*candidates, so("1m"));
+}
+
+/* x,y; x gets written before y is known to be valid */
+typedef struct Point {
+    ssize_t x, y;
+} Point;
+
+static int point_convert(void *val, So so, void *user) {
+    Point *point = val;
+    So y = SO;
+    So x = so_split_ch(so, ',', &y);
+    if(so_as_ssize(so_trim(x), &point->x, 0)) return -1;
+    if(so_as_ssize(so_trim(y), &point->y, 0)) return -1;
+    return 0;
+}
+
+/* a container of the caller: only the sum of all values gets kept */
+typedef struct Sum {
+    ssize_t total;
+    size_t n;
+    size_t n_bulk;
+} Sum;
+
+static int sum_convert(void *val, So so, void *user) {
+    Sum *sum = val;
+    ssize_t ms = 0;
+    if(duration_convert(&ms, so, user)) return -1;
+    sum->total += ms;
+    ++sum->n;
+    return 0;
+}
+
+static void sum_reset(void *val, void *user) {
+    *(Sum *)val = (Sum){0};
+}
+
+static int sum_convert_array(void *val, So so, void *user) {
+    Sum *sum = val;
+    ++sum->n_bulk;
+    if(so_at0(so) == '[' && so_atE(so) == ']') so = so_sub(so, 1, so_len(so) - 1);
+    for(So sp = SO; so_splice(so, &sp, ','); ) {
+        if(sum_convert(val, so_trim(sp), user)) return -1;
+    }
+    return 0;
+}
+
+int main(void) {
+    ssize_t timeout = 0;
+    ssize_t retry = 0;
+    Sum delays = {0};
+    Point origin = {0};
+
+    Argx_Type duration = {
+        .hint = so("duration"),
+        .size = sizeof(ssize_t),
+        .convert = duration_convert,
+        .fmt = duration_fmt,
+        .compgen = duration_compgen,
+    };
+    Argx_Type sum = {
+        .hint = so("duration-sum"),
+        .convert = sum_convert,
+        .convert_array = sum_convert_array,
+        .reset = sum_reset,
+    };
+
+    Argx_Type point = {
+        .hint = so("x,y"),
+        .size = sizeof(Point),
+        .convert = point_convert,
+    };
+
+    struct Arg_Config *cfg = arg_config_new();
+    struct Arg *arg = arg_new(cfg);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+
+    struct Argx *x = argx_opt(g, 't', so("timeout"), so("how long to wait"));
+      argx_type_custom(x, &duration, 0, &timeout, &(ssize_t){ 5000 });
+    x = argx_opt(g, 0, so("retry"), so("time between retries"));
+      argx_type_custom(x, &duration, 0, &retry, &(ssize_t){ 100 });
+    x = argx_opt(g, 0, so("delays"), so("delays to add up"));
+      argx_type_array_custom(x, &sum, 0, &delays);
+    x = argx_opt(g, 0, so("origin"), so("where to start"));
+      argx_type_custom(x, &point, 0, &origin, 0);
+
+    ASSERT(timeout == 5000, "expect the default");
+
+    arg_parse_config(arg, so("[default]\nretry = 2s\ndelays = [1s, 250ms]\n"), so("custom.conf"));
+
+    const char *argv[] = { "test", "-t", "2m", "--delays", "[10ms,20ms]" };
+    const int argc = sizeof(argv) / sizeof(*argv);
+    bool quit_early = false;
+    int result = arg_parse(arg, argc, argv, &quit_early);
+
+    ASSERT(!result, "expect a valid parse");
+    ASSERT(timeout == 120000, "expect the value converted in place, got %zi", timeout);
+    ASSERT(retry == 2000, "expect the value of the config, got %zi", retry);
+    ASSERT(delays.total == 1280 && delays.n == 4, "expect all values in the container, got %zi", delays.total);
+    ASSERT(delays.n_bulk == 3, "expect the bulk converter, got %zu", delays.n_bulk);
+
+    /* the container starts over with every parse */
+    arg_reset(arg);
+    const char *argv_again[] = { "test", "--delays", "5ms" };
+    result = arg_parse(arg, sizeof(argv_again) / sizeof(*argv_again), argv_again, &quit_early);
+    ASSERT(!result, "expect a valid parse");
+    ASSERT(delays.total == 5 && delays.n == 1, "expect only the values of this parse, got %zi", delays.total);
+
+    /* an invalid value leaves the last valid one as it was */
+    arg_reset(arg);
+    const char *argv_invalid[] = { "test", "--origin", "1,2", "--origin", "3,y" };
+    result = arg_parse(arg, sizeof(argv_invalid) / sizeof(*argv_invalid), argv_invalid, &quit_early);
+    ASSERT(result, "expect an invalid parse");
+    ASSERT(origin.x == 1 && origin.y == 2, "expect the valid value, got %zi,%zi", origin.x, origin.y);
+
+    arg_free(&arg);
+    arg_config_free(&cfg);
+    return 0;
+}
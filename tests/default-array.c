@@ -0,0 +1,44 @@
+#include "../rlarg.h"
+#include <rlc.h>
+
+int main(void) {
+    So *hosts = 0;
+    So *allow = 0;
+    for(size_t i = 0; i < 1000; ++i) {
+        array_push(allow, so("localhost"));
+    }
+
+    struct Arg_Config *cfg = arg_config_new();
+    struct Arg *arg = arg_new(cfg);
+    struct Argx_Group *g = argx_group(arg, so("Options"));
+
+    struct Argx *x = argx_opt(g, 'a', so("allow"), so("hosts to allow"));
+      argx_type_array_so(x, &hosts, &allow);
+
+    const char *argv[] = { "test" };
+    const int argc = sizeof(argv) / sizeof(*argv);
+    bool quit_early = false;
+    int result = arg_parse(arg, argc, argv, &quit_early);
+
+    ASSERT(!result, "expect parsing to succeed");
+    ASSERT(hosts == allow, "expect the default to be shared, not copied");
+
+    /* setting it replaces the default, also after the parse */
+    arg_parse_config(arg, so("[Options]\nallow = [example.org]\n"), so("test.conf"));
+    ASSERT(hosts != allow, "expect the value to have its own array");
+    ASSERT(array_len(hosts) == 1, "expect only the set value");
+    ASSERT(array_len(allow) == 1000, "expect the default to be untouched");
+
+    /* the same as a config parsed before, later sources add to it */
+    arg_reset(arg);
+    arg_parse_config(arg, so("[Options]\nallow = [example.org]\n"), so("test.conf"));
+    const char *argv2[] = { "test", "--allow", "example.com" };
+    result = arg_parse(arg, sizeof(argv2) / sizeof(*argv2), argv2, &quit_early);
+    ASSERT(!result, "expect parsing to succeed");
+    ASSERT(array_len(hosts) == 2, "expect the values of the config and argv, got %zu", array_len(hosts));
+    ASSERT(array_len(allow) == 1000, "expect the default to be untouched");
+
+    arg_free(&arg);
+    arg_config_free(&cfg);
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include "../rlarg.h"
+#include <rlc.h>
+#include <stdlib.h>
+
+int main(void) {
+    int jobs = 0;
+    int retries = 0;
+    So log_level = SO;
+    So db_host = SO;
+
+    struct Arg_Config *cfg = arg_config_new();
+    arg_config_set_env_prefix(cfg, so("MYAPP"));
+    struct Arg *arg = arg_new(cfg);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+
+    struct Argx *x = argx_opt(g, 'j', so("jobs"), so("number of jobs"));
+      argx_type_int(x, &jobs, &(int){ 1 });
+    x = argx_opt(g, 0, so("retries"), so("number of retries"));
+      argx_type_int(x, &retries, &(int){ 3 });
+    x = argx_opt(g, 0, so("log-level"), so("how much to log"));
+      argx_type_so(x, &log_level, 0);
+    x = argx_opt(g, 0, so("db"), so("database"));
+      struct Argx_Group *g2 = argx_group_options(x);
+        x = argx_opt(g2, 0, so("host"), so("host to connect to"));
+          argx_type_so(x, &db_host, 0);
+
+    setenv("MYAPP_DEFAULT_JOBS", "8", 1);
+    setenv("MYAPP_DEFAULT_RETRIES", "5", 1);
+    setenv("MYAPP_DEFAULT_LOG_LEVEL", "debug", 1);
+    setenv("MYAPP_DEFAULT_DB_HOST", "localhost", 1);
+    setenv("MYAPP_DEFAULT_NOPE", "ignored", 1);
+    setenv("OTHER_DEFAULT_JOBS", "16", 1);
+
+    /* the environment overrides configs */
+    arg_parse_config(arg, so("[default]\nretries = 7\n"), so("env-prefix.conf"));
+
+    /* argv overrides the environment */
+    const char *argv[] = { "test", "--jobs", "2" };
+    const int argc = sizeof(argv) / sizeof(*argv);
+    bool quit_early = false;
+    int result = arg_parse(arg, argc, argv, &quit_early);
+
+    ASSERT(!result, "expect unknown variables with the prefix to be ignored");
+    ASSERT(jobs == 2, "expect the value of argv");
+    ASSERT(retries == 5, "expect the environment over the config");
+    ASSERT(!so_cmp(log_level, so("debug")), "expect '-' to map to '_'");
+    ASSERT(!so_cmp(db_host, so("localhost")), "expect sub options to be reachable");
+
+    arg_free(&arg);
+    arg_config_free(&cfg);
+    return 0;
+}
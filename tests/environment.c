@@ -0,0 +1,83 @@
+#include "../rlarg.h"
+#include <rlc.h>
+#include <stdlib.h>
+
+extern char **environ;
+
+typedef struct Values {
+    So token;
+    int jobs;
+    int retries;
+} Values;
+
+static struct Arg *values_arg(struct Arg_Config *cfg, Values *values) {
+    static int jobs = 1, retries = 3;
+    struct Arg *arg = arg_new(cfg);
+    struct Argx *x = argx_env(arg, so("TOOL_TOKEN"), so("token to authenticate with"));
+      argx_type_so(x, &values->token, 0);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+    x = argx_opt(g, 'j', so("jobs"), so("number of jobs"));
+      argx_type_int(x, &values->jobs, &jobs);
+    x = argx_opt(g, 0, so("retries"), so("number of retries"));
+      argx_type_int(x, &values->retries, &retries);
+    return arg;
+}
+
+int main(void) {
+    char **saved = environ;
+    bool quit_early = false;
+
+    /* getenv takes the first of duplicates, so does the pass over environ */
+    char *env[] = {
+        "TOOL_TOKEN=first",
+        "MYAPP_DEFAULT_JOBS=8",
+        "MYAPP_DEFAULT_RETRIES=5",
+        "TOOL_TOKEN=second",
+        "MYAPP_DEFAULT_RETRIES=6",
+        0,
+    };
+    environ = env;
+
+    Values values = {0};
+    struct Arg_Config *cfg = arg_config_new();
+    arg_config_set_env_prefix(cfg, so("MYAPP"));
+    struct Arg *arg = values_arg(cfg, &values);
+
+    /* config < environment < argv */
+    arg_parse_config(arg, so("[default]\njobs = 4\nretries = 7\n"), so("environment.conf"));
+    const char *argv[] = { "tool", "--jobs", "2" };
+    int result = arg_parse(arg, sizeof(argv) / sizeof(*argv), argv, &quit_early);
+    ASSERT(!result, "expect a valid parse");
+    ASSERT(!so_cmp(values.token, so("first")), "expect the first of duplicates, got '%.*s'", SO_F(values.token));
+    ASSERT(values.retries == 5, "expect the first of duplicates over the config, got %i", values.retries);
+    ASSERT(values.jobs == 2, "expect argv over the environment, got %i", values.jobs);
+
+    /* nothing of the previous environment sticks to the next parse */
+    char *env2[] = { "MYAPP_DEFAULT_JOBS=9", 0 };
+    environ = env2;
+    arg_reset(arg);
+    const char *argv2[] = { "tool" };
+    result = arg_parse(arg, 1, argv2, &quit_early);
+    ASSERT(!result, "expect a valid parse");
+    ASSERT(!so_len(values.token), "expect no token, got '%.*s'", SO_F(values.token));
+    ASSERT(values.jobs == 9 && values.retries == 3, "expect the new environment, got %i and %i", values.jobs, values.retries);
+    arg_free(&arg);
+    arg_config_free(&cfg);
+
+    /* caller storage has no table, every variable is looked up with getenv */
+    environ = env;
+    static ARG_STORAGE(storage, 8, 2);
+    values = (Values){0};
+    cfg = arg_config_new();
+    arg_config_set_storage(cfg, storage, 8, 2);
+    arg = values_arg(cfg, &values);
+    result = arg_parse(arg, 1, argv2, &quit_early);
+    ASSERT(!result, "expect a valid parse");
+    ASSERT(!so_cmp(values.token, so("first")), "expect getenv to take the first, got '%.*s'", SO_F(values.token));
+    ASSERT(values.jobs == 1, "expect no prefix without it being configured");
+    arg_free(&arg);
+    arg_config_free(&cfg);
+
+    environ = saved;
+    return 0;
+}
@@ -0,0 +1,16 @@
+#include "../rlarg.h"
+#include <rlc.h>
+
+int main(void) {
+    struct Arg *arg = arg_new(0);
+    ASSERT(arg, "expect to have pointer");
+
+    struct Argx_Group *g1 = argx_group(arg, so("default"));
+
+    struct Argx *a = argx_opt(g1, 0, so("a"), so("desc"));
+    struct Argx *b = argx_opt(g1, 0, so("b"), so("desc"));
+    argx_callback_after(a, b);
+    argx_callback_after(b, a);
+
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include "../rlarg.h"
+#include <rlc.h>
+
+int main(void) {
+    uint64_t log = 0, trace = 0;
+    uint64_t log_ref = 0x3, trace_ref = 0x5;
+
+    struct Arg_Config *cfg = arg_config_new();
+    struct Arg *arg = arg_new(cfg);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+
+    struct Argx *x = argx_opt(g, 0, so("log"), so("log categories"));
+      struct Argx_Group *g2 = argx_group_flags_mask(x, &log, &log_ref);
+      So names = SO;
+      for(size_t i = 0; i < 64; ++i) {
+          so_fmt(&names, "f%zu", i);
+      }
+      for(size_t i = 0, n = 0; i < 64; ++i) {
+          size_t len = i < 10 ? 2 : 3;
+          argx_flag_bit(g2, so_i0(so_iE(names, n + len), n), so("a category"));
+          n += len;
+      }
+    x = argx_opt(g, 0, so("trace"), so("trace categories"));
+      g2 = argx_group_flags_mask(x, &trace, &trace_ref);
+        argx_flag_bit(g2, so("a"), so("a"));
+        argx_flag_bit(g2, so("b"), so("b"));
+        argx_flag_bit(g2, so("c"), so("c"));
+
+    ASSERT(log == log_ref, "expect the default right away");
+
+    /* the first explicit assignment replaces the default */
+    arg_parse_config(arg, so("[default]\nlog = f2,f63\n"), so("flags-mask.conf"));
+    ASSERT(log == ((1ULL << 2) | (1ULL << 63)), "expect the flags of the config");
+
+    const char *argv[] = { "test", "--log", "+f5,-f2" };
+    const int argc = sizeof(argv) / sizeof(*argv);
+    bool quit_early = false;
+    int result = arg_parse(arg, argc, argv, &quit_early);
+
+    ASSERT(!result, "expect a valid parse");
+    ASSERT(log == ((1ULL << 5) | (1ULL << 63)), "expect signed flags to modify the value");
+    ASSERT(trace == trace_ref, "expect the default");
+
+    so_free(&names);
+    arg_free(&arg);
+    arg_config_free(&cfg);
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "../rlarg.h"
+#include "../rlarg/arg-float.h"
+#include <rlc.h>
+#include <string.h>
+
+int main(void) {
+    double scale = 0, tiny = 0, big = 0, third = 0;
+    float ratio = 0;
+    double *weights = 0;
+    float *gains = 0;
+
+    struct Arg_Config *cfg = arg_config_new();
+    struct Arg *arg = arg_new(cfg);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+
+    struct Argx *x = argx_opt(g, 's', so("scale"), so("scale factor"));
+      argx_type_double(x, &scale, &(double){ 1.5 });
+    x = argx_opt(g, 0, so("tiny"), so("a subnormal"));
+      argx_type_double(x, &tiny, 0);
+    x = argx_opt(g, 0, so("big"), so("the largest double"));
+      argx_type_double(x, &big, 0);
+    x = argx_opt(g, 0, so("third"), so("more digits than fit"));
+      argx_type_double(x, &third, 0);
+    x = argx_opt(g, 'r', so("ratio"), so("a float"));
+      argx_type_float(x, &ratio, 0);
+    x = argx_opt(g, 0, so("weights"), so("many doubles"));
+      argx_type_array_double(x, &weights, 0);
+    x = argx_opt(g, 0, so("gains"), so("some floats"));
+      argx_type_array_float(x, &gains, 0);
+
+    ASSERT(scale == 1.5, "expect the default");
+
+    /* one big array, converted in bulk */
+    So conf = SO;
+    so_extend(&conf, so("[default]\nweights = ["));
+    for(size_t i = 0; i < 1000; ++i) {
+        so_fmt(&conf, "%s%zu.25e-3", i ? ", " : "", i);
+    }
+    so_extend(&conf, so("]\ngains = [0.1, -2.5e3, inf]\n"));
+    arg_parse_config(arg, conf, so("float.conf"));
+
+    const char *argv[] = { "test", "-s", "0.1", "--tiny", "1e-310", "--big", "1.7976931348623157e308",
+        "--third", "0.333333333333333333333333333333", "-r", "3.4028235e38", "--weights", "[1e23,-0]" };
+    const int argc = sizeof(argv) / sizeof(*argv);
+    bool quit_early = false;
+    int result = arg_parse(arg, argc, argv, &quit_early);
+
+    ASSERT(!result, "expect a valid parse");
+    ASSERT(scale == 0.1, "expect correct rounding, got %.17g", scale);
+    ASSERT(tiny == 1e-310 && tiny > 0, "expect a subnormal, got %.17g", tiny);
+    ASSERT(big == 1.7976931348623157e308, "expect the largest double, got %.17g", big);
+    ASSERT(third == 1.0 / 3.0, "expect the dropped digits to round, got %.17g", third);
+    ASSERT(ratio == 3.4028235e38f, "expect the largest float, got %.9g", ratio);
+    ASSERT(array_len(weights) == 1002, "expect all values, got %zu", array_len(weights));
+    ASSERT(array_at(weights, 999) == 999.25e-3, "expect the value of the config, got %.17g", array_at(weights, 999));
+    ASSERT(array_at(weights, 1000) == 1e23, "expect the value of argv, got %.17g", array_at(weights, 1000));
+    ASSERT(array_len(gains) == 3 && array_at(gains, 0) == 0.1f && array_at(gains, 1) == -2500.0f, "expect the floats of the config");
+
+    /* shortest text that converts back */
+    So out = SO;
+    arg_float_fmt_double(&out, 0.1);
+    ASSERT(!so_cmp(out, so("0.1")), "expect the shortest text, got %.*s", SO_F(out));
+    so_clear(&out);
+    arg_float_fmt_float(&out, 0.1f);
+    ASSERT(!so_cmp(out, so("0.1")), "expect the shortest text, got %.*s", SO_F(out));
+    so_clear(&out);
+    /* the smallest subnormals need a single digit */
+    arg_float_fmt_double(&out, 5e-324);
+    ASSERT(!so_cmp(out, so("5e-324")), "expect the shortest text, got %.*s", SO_F(out));
+    so_clear(&out);
+    arg_float_fmt_float(&out, 1e-45f);
+    ASSERT(!so_cmp(out, so("1e-45")), "expect the shortest text, got %.*s", SO_F(out));
+    so_clear(&out);
+    arg_float_fmt_double(&out, 1e23);
+    ASSERT(!so_cmp(out, so("1e+23")), "expect the shortest text, got %.*s", SO_F(out));
+    so_clear(&out);
+    double back = 0;
+    arg_float_fmt_double(&out, third);
+    ASSERT(!arg_float_as_double(out, &back) && !memcmp(&back, &third, sizeof(back)), "expect a round trip of %.*s", SO_F(out));
+
+    arg_reset(arg);
+    const char *argv_bad[] = { "test", "-s", "1.5x" };
+    result = arg_parse(arg, sizeof(argv_bad) / sizeof(*argv_bad), argv_bad, &quit_early);
+    ASSERT(result, "expect invalid text to be rejected");
+
+    so_free(&out);
+    so_free(&conf);
+    arg_free(&arg);
+    arg_config_free(&cfg);
+    return 0;
+}
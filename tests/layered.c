@@ -0,0 +1,43 @@
+#include "../rlarg.h"
+#include <rlc.h>
+
+int count_loads(struct Argx *argx, void *user, So so) {
+    size_t *loads = user;
+    ++*loads;
+    return 0;
+}
+
+int main(void) {
+    int jobs = 0;
+    So dict = SO;
+    size_t loads = 0;
+
+    struct Arg_Config *cfg = arg_config_new();
+    arg_config_set_layered(cfg, true);
+    struct Arg *arg = arg_new(cfg);
+    struct Argx_Group *g = argx_group(arg, so("Options"));
+
+    struct Argx *x = argx_opt(g, 'j', so("jobs"), so("number of jobs"));
+      argx_type_int(x, &jobs, &(int){ 1 });
+    x = argx_opt(g, 'd', so("dict"), so("dictionary to load"));
+      argx_type_so(x, &dict, 0);
+      argx_callback(x, count_loads, &loads, ARGX_PRIORITY_WHEN_ALL_VALID);
+
+    /* a lower layer, every value of it gets overridden */
+    So config = so("[Options]\njobs = many\ndict = file(\"does-not-exist.txt\")\n");
+    arg_parse_config(arg, config, so("layered.conf"));
+
+    const char *argv[] = { "test", "-d", "old.txt", "--jobs", "4", "--dict", "words.txt" };
+    const int argc = sizeof(argv) / sizeof(*argv);
+    bool quit_early = false;
+    int result = arg_parse(arg, argc, argv, &quit_early);
+
+    ASSERT(!result, "expect overridden values to never be converted or read");
+    ASSERT(jobs == 4, "expect the value of argv");
+    ASSERT(!so_cmp(dict, so("words.txt")), "expect the most recent value");
+    ASSERT(loads == 1, "expect the callback to only run for the winner");
+
+    arg_free(&arg);
+    arg_config_free(&cfg);
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "../rlarg.h"
+#include <rlc.h>
+#include <stdlib.h>
+
+typedef struct Tool {
+    So host;
+    int port;
+    bool fast;
+    bool safe;
+    size_t built_db;
+    size_t built_features;
+} Tool;
+
+void populate_db(struct Argx_Group *group, void *user) {
+    Tool *tool = user;
+    ++tool->built_db;
+    struct Argx *x = argx_opt(group, 0, so("host"), so("host to connect to"));
+      argx_type_so(x, &tool->host, 0);
+    x = argx_opt(group, 0, so("port"), so("port to connect to"));
+      argx_type_int(x, &tool->port, &(int){ 5432 });
+}
+
+void populate_features(struct Argx_Group *group, void *user) {
+    Tool *tool = user;
+    ++tool->built_features;
+    argx_flag(group, &tool->fast, &(bool){ false }, so("fast"), so("go fast"));
+    argx_flag(group, &tool->safe, &(bool){ true }, so("safe"), so("stay safe"));
+}
+
+static struct Arg *tool_arg(Tool *tool) {
+    *tool = (Tool){0};
+    struct Arg *arg = arg_new(0);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+    argx_builtin_opt_help(g, ARGX_BUILTIN_OPT_HELP);
+    arg_enable_config_print(arg, true);
+    struct Argx *x = argx_opt(g, 0, so("db"), so("database"));
+      argx_group_options_lazy(x, populate_db, tool);
+    x = argx_opt(g, 0, so("features"), so("what to enable"));
+      argx_group_flags_lazy(x, populate_features, tool);
+    return arg;
+}
+
+static int tool_parse(struct Arg *arg, int argc, const char **argv) {
+    bool quit_early = false;
+    return arg_parse(arg, argc, argv, &quit_early);
+}
+
+int main(void) {
+    Tool tool;
+
+    /* nothing reaches the groups */
+    struct Arg *arg = tool_arg(&tool);
+    const char *argv_none[] = { "tool" };
+    ASSERT(!tool_parse(arg, 1, argv_none), "expect a valid parse");
+    ASSERT(!tool.built_db && !tool.built_features, "expect untouched groups to never be built");
+    arg_free(&arg);
+
+    /* reached several times, built once */
+    arg = tool_arg(&tool);
+    arg_parse_config(arg, so("[default]\ndb.host = localhost\ndb.port = 1\n"), so("lazy-group.conf"));
+    const char *argv_parse[] = { "tool", "--features", "fast", "--db", "port=2" };
+    ASSERT(!tool_parse(arg, sizeof(argv_parse) / sizeof(*argv_parse), argv_parse), "expect a valid parse");
+    ASSERT(tool.built_db == 1 && tool.built_features == 1, "expect each group to be built once, got %zu %zu", tool.built_db, tool.built_features);
+    ASSERT(!so_cmp(tool.host, so("localhost")) && tool.port == 2, "expect the values of the config and argv");
+    ASSERT(tool.fast, "expect the flag of argv");
+    arg_free(&arg);
+
+    /* help of one group only builds that one */
+    arg = tool_arg(&tool);
+    const char *argv_help[] = { "tool", "--help", "default.db" };
+    tool_parse(arg, sizeof(argv_help) / sizeof(*argv_help), argv_help);
+    ASSERT(tool.built_db == 1 && !tool.built_features, "expect help to build only its group, got %zu %zu", tool.built_db, tool.built_features);
+    arg_free(&arg);
+
+    /* printing the config shows every value */
+    arg = tool_arg(&tool);
+    setenv("CONFIG_PRINT", "default", 1);
+    tool_parse(arg, 1, argv_none);
+    unsetenv("CONFIG_PRINT");
+    ASSERT(tool.built_db == 1 && tool.built_features == 1, "expect config print to build each group once, got %zu %zu", tool.built_db, tool.built_features);
+    arg_free(&arg);
+
+    return 0;
+}
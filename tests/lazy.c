@@ -0,0 +1,54 @@
+#include "../rlarg.h"
+#include <rlc.h>
+
+int count_loads(struct Argx *argx, void *user, So so) {
+    size_t *loads = user;
+    ++*loads;
+    return 0;
+}
+
+int main(void) {
+    int jobs = 0;
+    int level = 0;
+    int *ports = 0;
+    So dict = SO;
+    size_t loads = 0;
+
+    struct Arg_Config *cfg = arg_config_new();
+    arg_config_set_lazy(cfg, true);
+    struct Arg *arg = arg_new(cfg);
+    struct Argx_Group *g = argx_group(arg, so("Options"));
+
+    struct Argx *x_jobs = argx_opt(g, 'j', so("jobs"), so("number of jobs"));
+      argx_type_int(x_jobs, &jobs, &(int){ 1 });
+    struct Argx *x_level = argx_opt(g, 'l', so("level"), so("compression level"));
+      argx_type_int(x_level, &level, 0);
+    struct Argx *x_ports = argx_opt(g, 'p', so("ports"), so("ports to listen on"));
+      argx_type_array_int(x_ports, &ports, 0);
+    struct Argx *x_dict = argx_opt(g, 'd', so("dict"), so("dictionary to load"));
+      argx_type_so(x_dict, &dict, 0);
+      argx_callback(x_dict, count_loads, &loads, ARGX_PRIORITY_WHEN_ALL_VALID);
+
+    const char *argv[] = { "test", "-l", "high", "-p", "[80,443]", "-d", "words.txt" };
+    const int argc = sizeof(argv) / sizeof(*argv);
+    bool quit_early = false;
+    int result = arg_parse(arg, argc, argv, &quit_early);
+
+    ASSERT(!result, "expect parsing to succeed, nothing got converted");
+    ASSERT(jobs == 1, "expect an unset value to get its default");
+    ASSERT(!ports, "expect ports to not be converted yet");
+    ASSERT(!loads, "expect the callback to wait for the first access");
+
+    ASSERT(!argx_resolve(x_ports), "expect ports to convert");
+    ASSERT(array_len(ports) == 2 && array_at(ports, 1) == 443, "expect both ports");
+    ASSERT(!argx_resolve(x_dict), "expect dict to convert");
+    ASSERT(loads == 1 && !so_cmp(dict, so("words.txt")), "expect dict to be loaded once");
+    ASSERT(!argx_resolve(x_dict), "expect a second access to do nothing");
+    ASSERT(loads == 1, "expect the callback to run only once");
+
+    ASSERT(argx_resolve(x_level), "expect the conversion error on access");
+
+    arg_free(&arg);
+    arg_config_free(&cfg);
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include "../rlarg.h"
+#include <rlc.h>
+
+int main(void) {
+    Argx_So_Map *labels = 0;
+    Argx_So_Map *labels_ref = 0;
+    Argx_So_Map *tags = 0;
+    argx_so_map_set(&labels_ref, so("tier"), so("web"));
+
+    struct Arg_Config *cfg = arg_config_new();
+    struct Arg *arg = arg_new(cfg);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+
+    struct Argx *x = argx_opt(g, 'l', so("label"), so("labels"));
+      argx_type_map_so(x, &labels, &labels_ref);
+    x = argx_opt(g, 0, so("tag"), so("tags, each key once"));
+      argx_type_map_so(x, &tags, 0);
+      argx_attr_unique_keys(x, true);
+
+    ASSERT(!so_cmp(*argx_so_map_get(labels, so("tier")), so("web")), "expect the default");
+
+    /* the second config replaces the key of the first one */
+    arg_parse_config(arg, so("[default]\nlabel = [a=1, b=2]\ntag = x=1\n"), so("map1.conf"));
+    arg_parse_config(arg, so("[default]\nlabel = b=3\n"), so("map2.conf"));
+    ASSERT(!argx_so_map_get(labels, so("tier")), "expect the config to replace the default");
+    ASSERT(argx_so_map_len(labels) == 2, "expect 2 labels, got %zu", argx_so_map_len(labels));
+    ASSERT(!so_cmp(*argx_so_map_get(labels, so("b")), so("3")), "expect the last writer to win");
+
+    So where = SO;
+    argx_so_map_fmt_source(&where, labels, so("b"));
+    ASSERT(!so_cmp(where, so("map2.conf:2")), "expect the source of the key, got '%.*s'", SO_F(where));
+
+    /* argv overrides the configs, also a unique key */
+    const char *argv[] = { "test", "-l", "a=4", "--label", "c=", "--tag", "x=2" };
+    const int argc = sizeof(argv) / sizeof(*argv);
+    bool quit_early = false;
+    int result = arg_parse(arg, argc, argv, &quit_early);
+
+    ASSERT(!result, "expect argv to override the key of a config");
+    ASSERT(!so_cmp(*argx_so_map_get(tags, so("x")), so("2")), "expect the value of argv");
+    ASSERT(!so_cmp(*argx_so_map_get(labels, so("a")), so("4")), "expect argv to win");
+    ASSERT(argx_so_map_get(labels, so("c")) && !so_len(*argx_so_map_get(labels, so("c"))), "expect an empty value");
+    ASSERT(!so_cmp(argx_so_map_key(labels, 2), so("c")), "expect the order of first insertion");
+
+    so_clear(&where);
+    argx_so_map_fmt_source(&where, labels, so("a"));
+    ASSERT(!so_cmp(where, so("stdin@1")), "expect the source of the key, got '%.*s'", SO_F(where));
+
+    /* a unique key is only rejected within one source */
+    arg_reset(arg);
+    const char *argv_twice[] = { "test", "--tag", "x=1", "--tag", "x=2" };
+    result = arg_parse(arg, sizeof(argv_twice) / sizeof(*argv_twice), argv_twice, &quit_early);
+    ASSERT(result, "expect a duplicate key within argv to be rejected");
+    arg_reset(arg);
+    arg_parse_config(arg, so("[default]\ntag = [y=1, y=2]\n"), so("map3.conf"));
+    ASSERT(!so_cmp(*argx_so_map_get(tags, so("y")), so("1")), "expect a duplicate key within a config to be rejected");
+
+    so_free(&where);
+    arg_free(&arg);
+    arg_config_free(&cfg);
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "../rlarg.h"
+#include <rlc.h>
+
+typedef struct Indexer {
+    So dict;
+    So hosts;
+    bool index;
+    bool loaded_dict;
+    bool loaded_hosts;
+    bool indexed_after_load;
+} Indexer;
+
+int load_dict(struct Argx *argx, void *user, So so) {
+    Indexer *indexer = user;
+    indexer->loaded_dict = true;
+    return 0;
+}
+
+int load_hosts(struct Argx *argx, void *user, So so) {
+    Indexer *indexer = user;
+    indexer->loaded_hosts = true;
+    return !so_cmp(so, so("invalid"));
+}
+
+int build_index(struct Argx *argx, void *user, So so) {
+    Indexer *indexer = user;
+    indexer->indexed_after_load = indexer->loaded_dict && indexer->loaded_hosts;
+    return 0;
+}
+
+/* n_workers of 0 is one per callback, 1 runs all of them on the calling thread */
+static void run(size_t n_workers) {
+    Indexer indexer = {0};
+
+    struct Arg_Config *cfg = arg_config_new();
+    arg_config_set_parallel_workers(cfg, n_workers);
+    struct Arg *arg = arg_new(cfg);
+    struct Argx_Group *g = argx_group(arg, so("Options"));
+
+    struct Argx *dict = argx_opt(g, 'd', so("dict"), so("dictionary to load"));
+      argx_type_so(dict, &indexer.dict, 0);
+      argx_callback(dict, load_dict, &indexer, ARGX_PRIORITY_WHEN_ALL_VALID_PARALLEL);
+    struct Argx *hosts = argx_opt(g, 'H', so("hosts"), so("hosts file to resolve from"));
+      argx_type_so(hosts, &indexer.hosts, 0);
+      argx_callback(hosts, load_hosts, &indexer, ARGX_PRIORITY_WHEN_ALL_VALID_PARALLEL);
+    struct Argx *index = argx_opt(g, 'i', so("index"), so("build the index"));
+      argx_type_bool(index, &indexer.index, 0);
+      argx_callback(index, build_index, &indexer, ARGX_PRIORITY_WHEN_ALL_VALID_PARALLEL);
+      argx_callback_after(index, dict);
+      argx_callback_after(index, hosts);
+
+    const char *argv[] = { "indexer", "--index", "-d", "words.txt", "-H", "hosts.txt" };
+    const int argc = sizeof(argv) / sizeof(*argv);
+    bool quit_early = false;
+    int result = arg_parse(arg, argc, argv, &quit_early);
+
+    ASSERT(!result, "expect parsing to succeed with %zu workers", n_workers);
+    ASSERT(indexer.loaded_dict && indexer.loaded_hosts, "expect both loaders to run");
+    ASSERT(indexer.indexed_after_load, "expect index to wait for both loaders");
+
+    /* a failing callback fails the parse and keeps its dependents from running */
+    arg_reset(arg);
+    indexer = (Indexer){0};
+    const char *argv2[] = { "indexer", "-i", "-H", "invalid" };
+    const int argc2 = sizeof(argv2) / sizeof(*argv2);
+    result = arg_parse(arg, argc2, argv2, &quit_early);
+
+    ASSERT(result, "expect parsing to fail");
+    ASSERT(!indexer.indexed_after_load, "expect index to not run");
+
+    arg_free(&arg);
+    arg_config_free(&cfg);
+}
+
+int main(void) {
+    run(0);
+    run(1);
+    run(2);
+    return 0;
+}
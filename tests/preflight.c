@@ -0,0 +1,60 @@
+#include "../rlarg.h"
+#include <rlc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* the value of jobs after one parse, 2 if the config got loaded */
+static int parse(const char *conf, int argc, const char **argv) {
+    int jobs = 0;
+    So name = SO;
+    struct Arg *arg = arg_new(0);
+    argx_builtin_env_compgen(arg);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+    argx_builtin_opt_help(g, ARGX_BUILTIN_OPT_HELP);
+    argx_builtin_opt_version(g, 'V', so("version"), so("1.0"));
+    argx_builtin_opt_source(g, ARGX_BUILTIN_OPT_SOURCE, so_l(conf));
+    struct Argx *x = argx_opt(g, 'j', so("jobs"), so("number of jobs"));
+      argx_type_int(x, &jobs, 0);
+    x = argx_opt(g, 'n', so("name"), so("a name"));
+      argx_type_so(x, &name, 0);
+    bool quit_early = false;
+    arg_parse(arg, argc, argv, &quit_early);
+    arg_free(&arg);
+    return jobs;
+}
+
+int main(void) {
+    char dir[] = "/tmp/rlarg-preflight-XXXXXX";
+    ASSERT(mkdtemp(dir), "expect a temporary directory");
+    char conf[64];
+    snprintf(conf, sizeof(conf), "%s/tool.conf", dir);
+    FILE *file = fopen(conf, "wb");
+    ASSERT(file, "expect to write %s", conf);
+    fputs("[default]\njobs = 2\n", file);
+    fclose(file);
+
+    const char *argv[] = { "tool", "-n", "x" };
+    ASSERT(parse(conf, 3, argv) == 2, "expect a normal parse to load the config");
+
+    /* nothing of the config is shown, so it isn't read */
+    const char *argv_version[] = { "tool", "-n", "x", "--version" };
+    ASSERT(parse(conf, 4, argv_version) == 0, "expect --version to skip the config");
+    const char *argv_short[] = { "tool", "-V" };
+    ASSERT(parse(conf, 2, argv_short) == 0, "expect -V to skip the config");
+
+    /* the value of another option is no version option */
+    const char *argv_value[] = { "tool", "-n", "--version" };
+    ASSERT(parse(conf, 3, argv_value) == 2, "expect a value of --version to still load the config");
+
+    setenv("COMPGEN_WORDLIST", "true", 1);
+    setenv("COMPGEN_WORD", "--", 1);
+    const char *argv_compgen[] = { "tool", "--" };
+    ASSERT(parse(conf, 2, argv_compgen) == 0, "expect completion to skip the config");
+    unsetenv("COMPGEN_WORD");
+    unsetenv("COMPGEN_WORDLIST");
+
+    remove(conf);
+    rmdir(dir);
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include "../rlarg.h"
+#include <rlc.h>
+
+int main(void) {
+    Argx_Range *cpus = 0;
+    Argx_Range *cpus_ref = 0;
+    argx_range_add(&cpus_ref, 0, 3);
+
+    struct Arg_Config *cfg = arg_config_new();
+    struct Arg *arg = arg_new(cfg);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+
+    struct Argx *x = argx_opt(g, 'c', so("cpus"), so("cpus to run on"));
+      argx_type_array_range(x, &cpus, &cpus_ref);
+
+    ASSERT(argx_range_contains(cpus, 2), "expect the default");
+
+    arg_parse_config(arg, so("[default]\ncpus = [200-255, 8-15]\n"), so("range.conf"));
+    ASSERT(!argx_range_contains(cpus, 2), "expect the config to replace the default");
+
+    const char *argv[] = { "test", "-c", "0-7,128", "--cpus", "-4--2,250-300" };
+    const int argc = sizeof(argv) / sizeof(*argv);
+    bool quit_early = false;
+    int result = arg_parse(arg, argc, argv, &quit_early);
+
+    ASSERT(!result, "expect a valid parse");
+    ASSERT(array_len(cpus) == 4, "expect merged intervals, got %zu", array_len(cpus));
+    ASSERT(cpus[0].lo == -4 && cpus[0].hi == -2, "expect negative bounds");
+    ASSERT(cpus[1].lo == 0 && cpus[1].hi == 15, "expect adjacent ranges to merge");
+    ASSERT(cpus[3].lo == 200 && cpus[3].hi == 300, "expect overlapping ranges to merge");
+    ASSERT(argx_range_contains(cpus, 128) && !argx_range_contains(cpus, 127), "expect single values");
+
+    arg_free(&arg);
+    arg_config_free(&cfg);
+    return 0;
+}
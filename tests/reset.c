@@ -0,0 +1,48 @@
+#include "../rlarg.h"
+#include <rlc.h>
+
+typedef enum {
+    MODE_NONE,
+    MODE_FAST,
+} Mode;
+
+int main(void) {
+    So out = SO;
+    int n = 0;
+    bool v = false;
+    double d = 0;
+    Mode mode = MODE_NONE;
+
+    struct Arg *arg = arg_new(0);
+    struct Argx_Group *g = argx_group(arg, so("default")), *h;
+    struct Argx *x;
+    argx_builtin_opt_help(g, ARGX_BUILTIN_OPT_HELP);
+    /* none of them has a default */
+    x=argx_opt(g, 'o', so("out"), so("a string"));
+      argx_type_so(x, &out, 0);
+    x=argx_opt(g, 'n', so("number"), so("an integer"));
+      argx_type_int(x, &n, 0);
+    x=argx_opt(g, 'v', so("verbose"), so("a bool"));
+      argx_type_bool(x, &v, 0);
+    x=argx_opt(g, 'd', so("double"), so("a double"));
+      argx_type_double(x, &d, 0);
+    x=argx_opt(g, 'm', so("mode"), so("an enum"));
+      h=argx_group_enum(x, (int *)&mode, 0);
+      argx_enum_bind(h, MODE_FAST, so("fast"), so("fast mode"));
+
+    const char *argv[] = { "t", "-o", "first", "-n", "5", "-v", "-d", "0.5", "-m", "fast" };
+    bool quit_early = false;
+    int result = arg_parse(arg, sizeof(argv) / sizeof(*argv), argv, &quit_early);
+    ASSERT(!result, "expect a valid parse");
+    ASSERT(!so_cmp(out, so("first")) && n == 5 && v && d == 0.5 && mode == MODE_FAST, "expect the values of argv");
+
+    /* nothing of the first parse is left */
+    arg_reset(arg);
+    const char *argv_none[] = { "t" };
+    result = arg_parse(arg, 1, argv_none, &quit_early);
+    ASSERT(!result, "expect a valid parse");
+    ASSERT(!so_len(out) && !n && !v && !d && mode == MODE_NONE, "expect zero values, got out=%.*s n=%i v=%i", SO_F(out), n, v);
+
+    arg_free(&arg);
+    return 0;
+}
@@ -0,0 +1,35 @@
+#include "../rlarg.h"
+#include <rlc.h>
+
+int main(void) {
+    Argx_So_Set *hosts = 0;
+    Argx_So_Set *hosts_ref = 0;
+    argx_so_set_add(&hosts_ref, so("localhost"));
+
+    struct Arg_Config *cfg = arg_config_new();
+    struct Arg *arg = arg_new(cfg);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+
+    struct Argx *x = argx_opt(g, 'a', so("allow"), so("hosts to allow"));
+      argx_type_set_so(x, &hosts, &hosts_ref);
+
+    ASSERT(argx_so_set_has(hosts, so("localhost")), "expect the default");
+
+    arg_parse_config(arg, so("[default]\nallow = [a.org, b.org, a.org]\nallow = c.org\n"), so("set.conf"));
+    ASSERT(!argx_so_set_has(hosts, so("localhost")), "expect the config to replace the default");
+    ASSERT(argx_so_set_len(hosts) == 3, "expect duplicates to be dropped, got %zu", argx_so_set_len(hosts));
+
+    const char *argv[] = { "test", "-a", "b.org", "--allow", "[d.org,c.org]" };
+    const int argc = sizeof(argv) / sizeof(*argv);
+    bool quit_early = false;
+    int result = arg_parse(arg, argc, argv, &quit_early);
+
+    ASSERT(!result, "expect a valid parse");
+    ASSERT(argx_so_set_len(hosts) == 4, "expect 4 hosts, got %zu", argx_so_set_len(hosts));
+    ASSERT(argx_so_set_has(hosts, so("d.org")) && !argx_so_set_has(hosts, so("e.org")), "expect membership");
+    ASSERT(!so_cmp(array_at(argx_so_set_list(hosts), 3), so("d.org")), "expect the order of insertion");
+
+    arg_free(&arg);
+    arg_config_free(&cfg);
+    return 0;
+}
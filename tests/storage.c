@@ -0,0 +1,111 @@
+#include "../rlarg.h"
+#include <rlc.h>
+
+/* count allocations by standing in for those of glibc, unless a sanitizer already does */
+static size_t g_allocs;
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+#define COUNT_ALLOCS
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t n, size_t size);
+extern void *__libc_realloc(void *p, size_t size);
+
+void *malloc(size_t size) {
+    ++g_allocs;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size) {
+    ++g_allocs;
+    return __libc_calloc(n, size);
+}
+
+void *realloc(void *p, size_t size) {
+    ++g_allocs;
+    return __libc_realloc(p, size);
+}
+#endif
+
+typedef enum {
+    MODE_NONE,
+    MODE_FAST,
+    MODE_SLOW,
+} Mode;
+
+typedef struct Storage {
+    int i;
+    ssize_t z;
+    bool b;
+    So s;
+    Mode mode;
+    bool fa, fb;
+    So pos;
+} Storage;
+
+int main(void) {
+    Storage s = {0};
+    static ARG_STORAGE(storage, 16, 4);
+
+    struct Arg_Config *cfg = arg_config_new();
+    arg_config_set_storage(cfg, storage, 16, 4);
+    struct Arg *arg = arg_new(cfg);
+    arg_config_free(&cfg);
+
+    g_allocs = 0;
+    struct Argx_Group *g = argx_group(arg, so("default")), *h;
+    struct Argx *x;
+    x=argx_pos(arg, so("pos"), so("a positional"));
+      argx_type_so(x, &s.pos, 0);
+      argx_attr_required(x, true);
+    x=argx_opt(g, 'i', so("int"), so("an integer"));
+      argx_type_int(x, &s.i, &(int){ 3 });
+    x=argx_opt(g, 'z', so("size"), so("a size"));
+      argx_type_size(x, &s.z, &(ssize_t){ 7 });
+    x=argx_opt(g, 'b', so("bool"), so("a bool"));
+      argx_type_bool(x, &s.b, 0);
+    x=argx_opt(g, 0, so("string"), so("a string"));
+      argx_type_so(x, &s.s, 0);
+    x=argx_opt(g, 0, so("mode"), so("an enum"));
+      h=argx_group_enum(x, (int *)&s.mode, 0);
+      argx_enum_bind(h, MODE_FAST, so("fast"), so("fast mode"));
+      argx_enum_bind(h, MODE_SLOW, so("slow"), so("slow mode"));
+    x=argx_opt(g, 0, so("flags"), so("some flags"));
+      h=argx_group_flags(x);
+      argx_flag(h, &s.fa, 0, so("a"), so("flag a"));
+      argx_flag(h, &s.fb, 0, so("b"), so("flag b"));
+#ifdef COUNT_ALLOCS
+    ASSERT(!g_allocs, "expect registering to not allocate, got %zu allocations", g_allocs);
+#endif
+
+    const char *argv[] = { "storage", "-i", "42", "--bool", "--string=text", "--mode", "slow", "--flags", "b", "here" };
+    const int argc = sizeof(argv) / sizeof(*argv);
+    bool quit_early = false;
+    int result = arg_parse(arg, argc, argv, &quit_early);
+
+    ASSERT(!result, "expect parsing to succeed");
+    ASSERT(!quit_early, "expect to not quit early");
+    ASSERT(s.i == 42, "expect int to be parsed");
+    ASSERT(s.z == 7, "expect size to be set from reference");
+    ASSERT(s.b, "expect bool to be parsed");
+    ASSERT(!so_cmp(s.s, so("text")), "expect string to be parsed");
+    ASSERT(s.mode == MODE_SLOW, "expect enum to be parsed");
+    ASSERT(!s.fa && s.fb, "expect flags to be parsed");
+    ASSERT(!so_cmp(s.pos, so("here")), "expect positional to be parsed");
+
+    /* parse once more with the same arguments */
+    arg_reset(arg);
+    const char *argv2[] = { "storage", "-z", "9", "--flags", "a", "there" };
+    g_allocs = 0;
+    result = arg_parse(arg, sizeof(argv2) / sizeof(*argv2), argv2, &quit_early);
+#ifdef COUNT_ALLOCS
+    ASSERT(!g_allocs, "expect parsing to not allocate, got %zu allocations", g_allocs);
+#endif
+
+    ASSERT(!result, "expect parsing again to succeed");
+    ASSERT(s.i == 3, "expect int to be set from reference again");
+    ASSERT(s.z == 9, "expect size to be parsed");
+    ASSERT(s.fa && !s.fb, "expect the other flag to be cleared");
+    ASSERT(!so_cmp(s.pos, so("there")), "expect positional to be parsed again");
+
+    arg_free(&arg);
+    return 0;
+}
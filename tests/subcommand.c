@@ -0,0 +1,164 @@
+#include "../rlarg.h"
+#include <rlc.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+typedef enum {
+    CMD_NONE,
+    CMD_STATUS,
+    CMD_LOG,
+} Cmd;
+
+typedef struct Tool {
+    Cmd cmd;
+    bool short_status;
+    bool verbose_status;
+    bool verbose_log;
+    int count;
+    size_t built_status;
+    size_t built_log;
+} Tool;
+
+void populate_status(struct Argx_Group *group, void *user) {
+    Tool *tool = user;
+    ++tool->built_status;
+    struct Argx *x = argx_opt(group, 's', so("short"), so("give the output in the short format"));
+      argx_type_bool(x, &tool->short_status, 0);
+    x = argx_opt(group, 'v', so("verbose"), so("list untracked files too"));
+      argx_type_bool(x, &tool->verbose_status, &(bool){ false });
+}
+
+void populate_log(struct Argx_Group *group, void *user) {
+    Tool *tool = user;
+    ++tool->built_log;
+    struct Argx *x = argx_opt(group, 'n', so("max-count"), so("limit the number of commits"));
+      argx_type_int(x, &tool->count, &(int){ 10 });
+    x = argx_opt(group, 'v', so("verbose"), so("show the diff too"));
+      argx_type_bool(x, &tool->verbose_log, &(bool){ false });
+}
+
+static struct Arg *tool_arg(Tool *tool) {
+    struct Arg *arg = arg_new(0);
+    argx_builtin_env_compgen(arg);
+    struct Argx_Group *g = argx_group(arg, so("default"));
+    argx_builtin_opt_help(g, ARGX_BUILTIN_OPT_HELP);
+    struct Argx *x = argx_pos(arg, so("command"), so("the command to run"));
+    g = argx_group_enum(x, (int *)&tool->cmd, 0);
+      argx_subcommand(g, CMD_STATUS, so("status"), so("show the working tree status"), populate_status, tool);
+      argx_subcommand(g, CMD_LOG, so("log"), so("show commit logs"), populate_log, tool);
+    return arg;
+}
+
+/* what a fresh parser prints for one completion after an optional command, like a tab press, or the cache if asked */
+static bool complete(const char *path, So *out, const char *cmd, const char *word, bool cached) {
+    setenv("COMPGEN_WORD", word, 1);
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    dup2(fd, STDOUT_FILENO);
+    close(fd);
+    const char *argv[] = { "tool", cmd ? cmd : word, word };
+    const int argc = cmd ? 3 : 2;
+    bool valid = true;
+    if(cached) {
+        valid = arg_compgen_cached(argc, argv);
+    } else {
+        Tool tool = {0};
+        struct Arg *arg = tool_arg(&tool);
+        bool quit_early = false;
+        arg_parse(arg, argc, argv, &quit_early);
+        arg_free(&arg);
+    }
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    unsetenv("COMPGEN_WORD");
+    so_clear(out);
+    so_file_read(so_l(path), out);
+    return valid;
+}
+
+static bool has(So out, const char *word) {
+    So w = so_l(word);
+    for(size_t i = 0; i + so_len(w) <= so_len(out); ++i) {
+        if(!so_cmp(so_sub(out, i, i + so_len(w)), w)) return true;
+    }
+    return false;
+}
+
+int main(void) {
+    Tool tool = {0};
+
+    struct Arg_Config *cfg = arg_config_new();
+    struct Arg *arg = arg_new(cfg);
+    argx_builtin_opt_help(argx_group(arg, so("default")), ARGX_BUILTIN_OPT_HELP);
+
+    struct Argx *x = argx_pos(arg, so("command"), so("the command to run"));
+    struct Argx_Group *g = argx_group_enum(x, (int *)&tool.cmd, 0);
+      argx_subcommand(g, CMD_STATUS, so("status"), so("show the working tree status"), populate_status, &tool);
+      argx_subcommand(g, CMD_LOG, so("log"), so("show commit logs"), populate_log, &tool);
+
+    const char *argv[] = { "tool", "status", "-s" };
+    const int argc = sizeof(argv) / sizeof(*argv);
+    bool quit_early = false;
+    int result = arg_parse(arg, argc, argv, &quit_early);
+
+    ASSERT(!result, "expect parsing to succeed");
+    ASSERT(tool.cmd == CMD_STATUS, "expect status to be selected");
+    ASSERT(tool.short_status, "expect option of the subcommand to be parsed");
+    ASSERT(tool.built_status == 1, "expect status to be built once");
+    ASSERT(!tool.built_log, "expect log to never be built");
+
+    /* both subcommands have a --verbose of their own */
+    const char *argv_status[] = { "tool", "status", "--verbose" };
+    arg_reset(arg);
+    result = arg_parse(arg, sizeof(argv_status) / sizeof(*argv_status), argv_status, &quit_early);
+    ASSERT(!result && tool.verbose_status, "expect the option of status");
+    const char *argv_log[] = { "tool", "log", "-v", "--max-count", "3" };
+    arg_reset(arg);
+    result = arg_parse(arg, sizeof(argv_log) / sizeof(*argv_log), argv_log, &quit_early);
+    ASSERT(!result && tool.cmd == CMD_LOG, "expect log to be selected");
+    ASSERT(tool.verbose_log && !tool.verbose_status && tool.count == 3, "expect the options of log only");
+    const char *argv_other[] = { "tool", "log", "--short" };
+    arg_reset(arg);
+    result = arg_parse(arg, sizeof(argv_other) / sizeof(*argv_other), argv_other, &quit_early);
+    ASSERT(result, "expect an option of another subcommand to be rejected");
+
+    /* completion, from the parser, the cache and the script */
+    char dir[] = "/tmp/rlarg-subcommand-XXXXXX";
+    ASSERT(mkdtemp(dir), "expect a temporary directory");
+    char cache[64], path[64];
+    snprintf(cache, sizeof(cache), "%s/cache", dir);
+    snprintf(path, sizeof(path), "%s/out", dir);
+    So out = SO;
+    setenv("COMPGEN_WORDLIST", "true", 1);
+    setenv("COMPGEN_CACHE", cache, 1);
+    /* the parser knows the command line: only the options of the selected subcommand */
+    complete(path, &out, 0, "--", false);
+    ASSERT(has(out, "--help") && !has(out, "--short") && !has(out, "--max-count"), "expect no options of an unselected subcommand");
+    complete(path, &out, "status", "--", false);
+    ASSERT(has(out, "--short") && has(out, "--verbose") && !has(out, "--max-count"), "expect the options of status");
+    complete(path, &out, "log", "--", false);
+    ASSERT(has(out, "--max-count") && has(out, "--verbose") && !has(out, "--short"), "expect the options of log");
+    /* the cache does not, it has the options of both */
+    ASSERT(complete(path, &out, 0, "--", true), "expect a cache with both subcommands");
+    ASSERT(has(out, "--short") && has(out, "--max-count") && has(out, "--verbose"), "expect the options of both subcommands in the cache");
+    unsetenv("COMPGEN_CACHE");
+    unsetenv("COMPGEN_WORDLIST");
+    setenv("COMPGEN_SCRIPT", "true", 1);
+    complete(path, &out, 0, "", false);
+    unsetenv("COMPGEN_SCRIPT");
+    ASSERT(has(out, "_complete_tool()"), "expect the script to define the completion function, got '%.*s'", SO_F(out));
+    ASSERT(has(out, "--short") && has(out, "--max-count"), "expect the script to have both subcommands");
+    ASSERT(has(out, "status") && has(out, "log"), "expect the script to have the subcommands");
+    remove(path);
+    remove(cache);
+    rmdir(dir);
+    so_free(&out);
+
+    arg_free(&arg);
+    arg_config_free(&cfg);
+    return 0;
+}